@@ -5,10 +5,21 @@
 //----------------------------------------------------------------------------------------------------
 #include "Game/Convex.hpp"
 #include "Game/BVH.hpp"
+#include "Game/RaySlab.hpp"
 
+#include "Engine/Core/ErrorWarningAssert.hpp"
 #include "Engine/Math/RaycastUtils.hpp"
 
+#include <algorithm>
 #include <cfloat>
+#include <cmath>
+
+//----------------------------------------------------------------------------------------------------
+// A depth-first walk holds at most one pending sibling per level plus the node being expanded, so these
+// fit any tree within MAX_AABB2_TREE_DEPTH. A BVH4 is never deeper than the binary tree it came from.
+//----------------------------------------------------------------------------------------------------
+constexpr int AABB2_TREE_STACK_SIZE  = MAX_AABB2_TREE_DEPTH + 1;
+constexpr int AABB2_TREE4_STACK_SIZE = 3 * MAX_AABB2_TREE_DEPTH + 1;
 
 //----------------------------------------------------------------------------------------------------
 static int IntPow_BVH(int x, unsigned int p)
@@ -21,10 +32,40 @@ static int IntPow_BVH(int x, unsigned int p)
 	return x * tmp * tmp;
 }
 
+//----------------------------------------------------------------------------------------------------
+// Tight AABB2 around the vertices of count convexes, or the (-1,-1)-(0,0) placeholder when empty
+//----------------------------------------------------------------------------------------------------
+static AABB2 ComputeTightBounds_BVH(Convex2* const* convexes, int count)
+{
+	if (count == 0)
+	{
+		return AABB2(Vec2(-1.f, -1.f), Vec2(0.f, 0.f));
+	}
+
+	float minX = FLT_MAX, maxX = -FLT_MAX;
+	float minY = FLT_MAX, maxY = -FLT_MAX;
+	for (int i = 0; i < count; ++i)
+	{
+		for (auto const& vert : convexes[i]->m_convexPoly.GetVertexArray())
+		{
+			if (vert.x > maxX) maxX = vert.x;
+			if (vert.x < minX) minX = vert.x;
+			if (vert.y < minY) minY = vert.y;
+			if (vert.y > maxY) maxY = vert.y;
+		}
+	}
+	return AABB2(Vec2(minX, minY), Vec2(maxX, maxY));
+}
+
 //----------------------------------------------------------------------------------------------------
 void AABB2Tree::BuildTree(std::vector<Convex2*> const& convexArray, int numOfRecursive, AABB2 const& totalBounds)
 {
 	m_nodes.clear();
+	m_primitives.clear();
+	InitRefitData();
+	m_startOfLastLevel = 0;
+	m_buildMethod      = eAABB2TreeBuildMethod::MIDPOINT;
+	numOfRecursive     = std::min(numOfRecursive, MAX_AABB2_TREE_DEPTH + 1);
 
 	int numOfNodes = 0;
 	for (int i = 0; i < numOfRecursive; ++i)
@@ -36,103 +77,464 @@ void AABB2Tree::BuildTree(std::vector<Convex2*> const& convexArray, int numOfRec
 	{
 		return;
 	}
-	m_nodes[0].m_containingConvex = convexArray;
 
-	int sumK = 0;
-	for (int i = 0; i < numOfRecursive; ++i)
+	m_primitives = convexArray;
+	m_nodes[0].m_bounds    = totalBounds;
+	m_nodes[0].m_firstPrim = 0;
+	m_nodes[0].m_numPrims  = static_cast<int>(m_primitives.size());
+
+	// Each level partitions its parent's range in place, so siblings end up adjacent in m_primitives
+	int sumK = 1;
+	for (int i = 1; i < numOfRecursive; ++i)
 	{
-		if (i == 0)
+		int numOfJInLevel = IntPow_BVH(2, i);
+		if (i == numOfRecursive - 1)
 		{
-			m_nodes[sumK].m_bounds = totalBounds;
-			++sumK;
+			m_startOfLastLevel = sumK;
 		}
-		else
+		bool isVerticalSplit = (i % 2 == 1);
+
+		for (int j = 0; j < numOfJInLevel; j += 2, sumK += 2)
 		{
-			int numOfJInLevel = IntPow_BVH(2, i);
-			if (i == numOfRecursive - 1)
+			int parentIndex = GetParentIndex(sumK);
+			AABB2TreeNode& parent = m_nodes[parentIndex];
+			Convex2** rangeBegin = m_primitives.data() + parent.m_firstPrim;
+			Convex2** rangeEnd   = rangeBegin + parent.m_numPrims;
+			Convex2** rangeMid;
+
+			if (isVerticalSplit)
 			{
-				m_startOfLastLevel = sumK;
+				float xPivot = (parent.m_bounds.m_maxs.x + parent.m_bounds.m_mins.x) * 0.5f;
+				rangeMid = std::partition(rangeBegin, rangeEnd, [xPivot](Convex2 const* convex) { return convex->m_boundingDiscCenter.x < xPivot; });
 			}
-			for (int j = 0; j < numOfJInLevel; ++j)
+			else
 			{
-				int parentIndex = GetParentIndex(sumK);
-				AABB2 const& parentBounds = m_nodes[parentIndex].m_bounds;
-				bool isLeftChild = (sumK == parentIndex * 2 + 1);
-				bool isVerticalSplit = (i % 2 == 1);
+				float yPivot = (parent.m_bounds.m_maxs.y + parent.m_bounds.m_mins.y) * 0.5f;
+				rangeMid = std::partition(rangeBegin, rangeEnd, [yPivot](Convex2 const* convex) { return convex->m_boundingDiscCenter.y >= yPivot; });
+			}
 
-				if (isVerticalSplit)
-				{
-					float xPivot = (parentBounds.m_maxs.x + parentBounds.m_mins.x) * 0.5f;
-					for (auto convex : m_nodes[parentIndex].m_containingConvex)
-					{
-						bool goesLeft = convex->m_boundingDiscCenter.x < xPivot;
-						if (isLeftChild == goesLeft)
-						{
-							m_nodes[sumK].m_containingConvex.push_back(convex);
-						}
-					}
-				}
-				else
-				{
-					float yPivot = (parentBounds.m_maxs.y + parentBounds.m_mins.y) * 0.5f;
-					for (auto convex : m_nodes[parentIndex].m_containingConvex)
-					{
-						bool goesTop = convex->m_boundingDiscCenter.y >= yPivot;
-						if (isLeftChild == goesTop)
-						{
-							m_nodes[sumK].m_containingConvex.push_back(convex);
-						}
-					}
-				}
+			parent.m_leftChild  = sumK;
+			parent.m_rightChild = sumK + 1;
 
-				// Compute tight AABB from contained convex vertices
-				if (!m_nodes[sumK].m_containingConvex.empty())
-				{
-					float minX = FLT_MAX, maxX = -FLT_MAX;
-					float minY = FLT_MAX, maxY = -FLT_MAX;
-					for (auto convex : m_nodes[sumK].m_containingConvex)
-					{
-						for (auto const& vert : convex->m_convexPoly.GetVertexArray())
-						{
-							if (vert.x > maxX) maxX = vert.x;
-							if (vert.x < minX) minX = vert.x;
-							if (vert.y < minY) minY = vert.y;
-							if (vert.y > maxY) maxY = vert.y;
-						}
-					}
-					m_nodes[sumK].m_bounds = AABB2(Vec2(minX, minY), Vec2(maxX, maxY));
-				}
-				else
-				{
-					m_nodes[sumK].m_bounds = AABB2(Vec2(-1.f, -1.f), Vec2(0.f, 0.f));
-				}
-				++sumK;
+			AABB2TreeNode& leftNode  = m_nodes[sumK];
+			AABB2TreeNode& rightNode = m_nodes[sumK + 1];
+			leftNode.m_firstPrim  = parent.m_firstPrim;
+			leftNode.m_numPrims   = static_cast<int>(rangeMid - rangeBegin);
+			rightNode.m_firstPrim = parent.m_firstPrim + leftNode.m_numPrims;
+			rightNode.m_numPrims  = static_cast<int>(rangeEnd - rangeMid);
+			leftNode.m_bounds     = ComputeTightBounds_BVH(rangeBegin, leftNode.m_numPrims);
+			rightNode.m_bounds    = ComputeTightBounds_BVH(rangeMid, rightNode.m_numPrims);
+		}
+	}
+
+	InitRefitData();
+}
+
+//----------------------------------------------------------------------------------------------------
+// Binned SAH build
+//
+// In 2D the chance that a random ray crosses a box is proportional to its perimeter, so the
+// "surface area" term is the half perimeter (w + h). Each node tries NUM_BINS centroid bins on both
+// axes and takes the cheapest split; it becomes a leaf when no split beats intersecting everything
+// (and it is already small enough), or when all centroids coincide.
+//----------------------------------------------------------------------------------------------------
+struct SAHBuildPrim
+{
+	Convex2* m_convex;
+	AABB2    m_bounds;
+	Vec2     m_centroid;
+};
+
+struct SAHBin
+{
+	AABB2 m_bounds;
+	int   m_count = 0;
+};
+
+constexpr float SAH_TRAVERSAL_COST = 0.5f;  // One box test relative to one convex hull test
+constexpr int   SAH_MAX_BINS       = 32;
+
+//----------------------------------------------------------------------------------------------------
+static AABB2 MakeEmptyBounds_BVH()
+{
+	return AABB2(Vec2(FLT_MAX, FLT_MAX), Vec2(-FLT_MAX, -FLT_MAX));
+}
+
+//----------------------------------------------------------------------------------------------------
+static void GrowBounds_BVH(AABB2& bounds, AABB2 const& other)
+{
+	if (other.m_mins.x < bounds.m_mins.x) bounds.m_mins.x = other.m_mins.x;
+	if (other.m_mins.y < bounds.m_mins.y) bounds.m_mins.y = other.m_mins.y;
+	if (other.m_maxs.x > bounds.m_maxs.x) bounds.m_maxs.x = other.m_maxs.x;
+	if (other.m_maxs.y > bounds.m_maxs.y) bounds.m_maxs.y = other.m_maxs.y;
+}
+
+//----------------------------------------------------------------------------------------------------
+static float GetHalfPerimeter_BVH(AABB2 const& bounds)
+{
+	if (bounds.m_maxs.x < bounds.m_mins.x) return 0.f;
+	return (bounds.m_maxs.x - bounds.m_mins.x) + (bounds.m_maxs.y - bounds.m_mins.y);
+}
+
+//----------------------------------------------------------------------------------------------------
+static float GetAxis_BVH(Vec2 const& v, int axis)
+{
+	return (axis == 0) ? v.x : v.y;
+}
+
+//----------------------------------------------------------------------------------------------------
+static int BuildSAHNode(std::vector<AABB2TreeNode>& nodes, std::vector<SAHBuildPrim>& prims, int first, int count, int depth, int maxLeafSize, int numOfBins)
+{
+	int nodeIndex = static_cast<int>(nodes.size());
+	nodes.emplace_back();
+
+	AABB2 bounds         = MakeEmptyBounds_BVH();
+	AABB2 centroidBounds = MakeEmptyBounds_BVH();
+	for (int i = first; i < first + count; ++i)
+	{
+		GrowBounds_BVH(bounds, prims[i].m_bounds);
+		GrowBounds_BVH(centroidBounds, AABB2(prims[i].m_centroid, prims[i].m_centroid));
+	}
+	nodes[nodeIndex].m_bounds    = bounds;
+	nodes[nodeIndex].m_firstPrim = first;
+	nodes[nodeIndex].m_numPrims  = count;
+
+	if (count <= 1 || depth >= MAX_AABB2_TREE_DEPTH)
+	{
+		return nodeIndex;
+	}
+
+	// Find the cheapest bin boundary over both axes
+	float bestCost  = FLT_MAX;
+	int   bestAxis  = -1;
+	int   bestSplit = 0;
+	for (int axis = 0; axis < 2; ++axis)
+	{
+		float axisMin = GetAxis_BVH(centroidBounds.m_mins, axis);
+		float axisMax = GetAxis_BVH(centroidBounds.m_maxs, axis);
+		if (axisMax <= axisMin) continue;
+
+		SAHBin bins[SAH_MAX_BINS];
+		for (int b = 0; b < numOfBins; ++b) bins[b].m_bounds = MakeEmptyBounds_BVH();
+
+		float binScale = static_cast<float>(numOfBins) / (axisMax - axisMin);
+		for (int i = first; i < first + count; ++i)
+		{
+			int b = static_cast<int>((GetAxis_BVH(prims[i].m_centroid, axis) - axisMin) * binScale);
+			if (b >= numOfBins) b = numOfBins - 1;
+			++bins[b].m_count;
+			GrowBounds_BVH(bins[b].m_bounds, prims[i].m_bounds);
+		}
+
+		// Sweep from the right to get suffix areas, then from the left to evaluate each boundary
+		float rightArea[SAH_MAX_BINS];
+		int   rightCount[SAH_MAX_BINS];
+		AABB2 sweep = MakeEmptyBounds_BVH();
+		int   sweepCount = 0;
+		for (int b = numOfBins - 1; b > 0; --b)
+		{
+			GrowBounds_BVH(sweep, bins[b].m_bounds);
+			sweepCount += bins[b].m_count;
+			rightArea[b]  = GetHalfPerimeter_BVH(sweep);
+			rightCount[b] = sweepCount;
+		}
+
+		sweep      = MakeEmptyBounds_BVH();
+		sweepCount = 0;
+		for (int b = 0; b < numOfBins - 1; ++b)
+		{
+			GrowBounds_BVH(sweep, bins[b].m_bounds);
+			sweepCount += bins[b].m_count;
+			if (sweepCount == 0 || rightCount[b + 1] == 0) continue;
+
+			float cost = GetHalfPerimeter_BVH(sweep) * static_cast<float>(sweepCount) + rightArea[b + 1] * static_cast<float>(rightCount[b + 1]);
+			if (cost < bestCost)
+			{
+				bestCost  = cost;
+				bestAxis  = axis;
+				bestSplit = b + 1;
 			}
 		}
 	}
+
+	if (bestAxis < 0)
+	{
+		// All centroids coincide; only split (by index) when the leaf would be too big
+		if (count <= maxLeafSize)
+		{
+			return nodeIndex;
+		}
+		int half = count / 2;
+		int leftChild  = BuildSAHNode(nodes, prims, first, half, depth + 1, maxLeafSize, numOfBins);
+		int rightChild = BuildSAHNode(nodes, prims, first + half, count - half, depth + 1, maxLeafSize, numOfBins);
+		nodes[nodeIndex].m_leftChild  = leftChild;
+		nodes[nodeIndex].m_rightChild = rightChild;
+		return nodeIndex;
+	}
+
+	float parentArea = GetHalfPerimeter_BVH(bounds);
+	float splitCost  = SAH_TRAVERSAL_COST + ((parentArea > 0.f) ? bestCost / parentArea : 0.f);
+	float leafCost   = static_cast<float>(count);
+	if (splitCost >= leafCost && count <= maxLeafSize)
+	{
+		return nodeIndex;
+	}
+
+	// Partition in place around the chosen bin boundary
+	float axisMin  = GetAxis_BVH(centroidBounds.m_mins, bestAxis);
+	float binScale = static_cast<float>(numOfBins) / (GetAxis_BVH(centroidBounds.m_maxs, bestAxis) - axisMin);
+	int   mid      = first;
+	for (int i = first; i < first + count; ++i)
+	{
+		int b = static_cast<int>((GetAxis_BVH(prims[i].m_centroid, bestAxis) - axisMin) * binScale);
+		if (b >= numOfBins) b = numOfBins - 1;
+		if (b < bestSplit)
+		{
+			std::swap(prims[i], prims[mid]);
+			++mid;
+		}
+	}
+
+	int leftChild  = BuildSAHNode(nodes, prims, first, mid - first, depth + 1, maxLeafSize, numOfBins);
+	int rightChild = BuildSAHNode(nodes, prims, mid, first + count - mid, depth + 1, maxLeafSize, numOfBins);
+	nodes[nodeIndex].m_leftChild  = leftChild;
+	nodes[nodeIndex].m_rightChild = rightChild;
+	return nodeIndex;
 }
 
 //----------------------------------------------------------------------------------------------------
-static bool RayHitsAABB2D_BVH(Vec2 const& startPos, Vec2 const& forwardVec, float maxDist, AABB2 const& bounds)
+void AABB2Tree::BuildTreeSAH(std::vector<Convex2*> const& convexArray, int maxLeafSize, int numOfBins)
 {
-	RaycastResult2D result = RaycastVsAABB2D(startPos, forwardVec, maxDist, bounds.m_mins, bounds.m_maxs);
-	return result.m_didImpact;
+	// Reset everything the previous build left, so an empty scene leaves no stale convexes behind
+	m_nodes.clear();
+	m_primitives.clear();
+	InitRefitData();
+	m_startOfLastLevel = 0;
+	m_buildMethod      = eAABB2TreeBuildMethod::SAH;
+
+	if (convexArray.empty())
+	{
+		return;
+	}
+	if (maxLeafSize < 1) maxLeafSize = 1;
+	if (numOfBins < 2) numOfBins = 2;
+	if (numOfBins > SAH_MAX_BINS) numOfBins = SAH_MAX_BINS;
+
+	std::vector<SAHBuildPrim> prims;
+	prims.reserve(convexArray.size());
+	for (Convex2* convex : convexArray)
+	{
+		SAHBuildPrim prim;
+		prim.m_convex   = convex;
+		prim.m_bounds   = convex->m_boundingAABB;
+		prim.m_centroid = (convex->m_boundingAABB.m_mins + convex->m_boundingAABB.m_maxs) * 0.5f;
+		prims.push_back(prim);
+	}
+
+	m_nodes.reserve(convexArray.size() * 2);
+	BuildSAHNode(m_nodes, prims, 0, static_cast<int>(prims.size()), 0, maxLeafSize, numOfBins);
+	m_nodes.shrink_to_fit();
+
+	// prims was partitioned in place, so its order is the leaf order
+	m_primitives.reserve(prims.size());
+	for (SAHBuildPrim const& prim : prims)
+	{
+		m_primitives.push_back(prim.m_convex);
+	}
+
+	InitRefitData();
 }
 
 //----------------------------------------------------------------------------------------------------
-void AABB2Tree::SolveRayResult(Vec2 const& startPos, Vec2 const& forwardVec, float maxDist, std::vector<Convex2*>& out_latentRes)
+// Post-order walk that appends each leaf's list and gives every interior node the union of its children
+//----------------------------------------------------------------------------------------------------
+static void AssignLeafRanges_BVH(std::vector<AABB2TreeNode>& nodes, std::vector<Convex2*>& primitives, std::vector<std::vector<Convex2*>> const& leafContents, int nodeIndex)
 {
+	int firstPrim = static_cast<int>(primitives.size());
+
+	if (nodes[nodeIndex].m_leftChild < 0)
+	{
+		if (nodeIndex < static_cast<int>(leafContents.size()))
+		{
+			primitives.insert(primitives.end(), leafContents[nodeIndex].begin(), leafContents[nodeIndex].end());
+		}
+	}
+	else
+	{
+		AssignLeafRanges_BVH(nodes, primitives, leafContents, nodes[nodeIndex].m_leftChild);
+		AssignLeafRanges_BVH(nodes, primitives, leafContents, nodes[nodeIndex].m_rightChild);
+	}
+
+	nodes[nodeIndex].m_firstPrim = firstPrim;
+	nodes[nodeIndex].m_numPrims  = static_cast<int>(primitives.size()) - firstPrim;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool AABB2Tree::SetLeafContents(std::vector<std::vector<Convex2*>> const& leafContents)
+{
+	m_primitives.clear();
+	if (m_nodes.empty())
+	{
+		return true;
+	}
+
+	// Every node except the root needs exactly one parent, and children always come after their parent
+	// (true for both builders), which rules out cycles and shared subtrees in loaded data. That order also
+	// settles each node's depth before its children are reached, so deeper trees than the traversal
+	// stacks hold are rejected in the same pass.
+	int const numNodes = static_cast<int>(m_nodes.size());
+	std::vector<int> numParents(numNodes, 0);
+	std::vector<int> depths(numNodes, 0);
+	for (int n = 0; n < numNodes; ++n)
+	{
+		AABB2TreeNode const& node = m_nodes[n];
+		if (node.m_leftChild < 0 && node.m_rightChild < 0)
+		{
+			continue;
+		}
+		if (node.m_leftChild <= n || node.m_rightChild <= n || node.m_leftChild >= numNodes || node.m_rightChild >= numNodes)
+		{
+			return false;
+		}
+		++numParents[node.m_leftChild];
+		++numParents[node.m_rightChild];
+
+		int const childDepth = depths[n] + 1;
+		if (childDepth > MAX_AABB2_TREE_DEPTH)
+		{
+			return false;
+		}
+		depths[node.m_leftChild]  = childDepth;
+		depths[node.m_rightChild] = childDepth;
+	}
+	for (int n = 1; n < numNodes; ++n)
+	{
+		if (numParents[n] != 1)
+		{
+			return false;
+		}
+	}
+
+	AssignLeafRanges_BVH(m_nodes, m_primitives, leafContents, 0);
+	InitRefitData();
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+size_t AABB2Tree::GetMemoryFootprintBytes() const
+{
+	size_t bytes = m_nodes.capacity() * sizeof(AABB2TreeNode) + m_primitives.capacity() * sizeof(Convex2*);
+	bytes += m_parentIndices.capacity() * sizeof(int);
+	bytes += m_leafOfConvex.bucket_count() * sizeof(void*) + m_leafOfConvex.size() * (sizeof(std::pair<Convex2 const*, int>) + sizeof(void*));
+	return bytes;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Refit
+//----------------------------------------------------------------------------------------------------
+static float GetNodeCost_BVH(AABB2TreeNode const& node)
+{
+	// Empty midpoint nodes keep a placeholder box that no ray should pay for
+	return (node.m_numPrims > 0) ? GetHalfPerimeter_BVH(node.m_bounds) : 0.f;
+}
+
+//----------------------------------------------------------------------------------------------------
+void AABB2Tree::InitRefitData()
+{
+	int const numNodes = static_cast<int>(m_nodes.size());
+
+	m_parentIndices.assign(numNodes, -1);
+	m_leafOfConvex.clear();
+	m_currentCost = 0.f;
+	for (int n = 0; n < numNodes; ++n)
+	{
+		AABB2TreeNode const& node = m_nodes[n];
+		m_currentCost += GetNodeCost_BVH(node);
+		if (node.m_leftChild >= 0)
+		{
+			m_parentIndices[node.m_leftChild]  = n;
+			m_parentIndices[node.m_rightChild] = n;
+			continue;
+		}
+
+		Convex2* const* prims = GetNodePrimitives(node);
+		for (int i = 0; i < node.m_numPrims; ++i)
+		{
+			m_leafOfConvex[prims[i]] = n;
+		}
+	}
+	m_builtCost = m_currentCost;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool AABB2Tree::RefitConvex(Convex2 const* convex)
+{
+	auto found = m_leafOfConvex.find(convex);
+	if (found == m_leafOfConvex.end())
+	{
+		return false;
+	}
+
+	for (int nodeIndex = found->second; nodeIndex >= 0; nodeIndex = m_parentIndices[nodeIndex])
+	{
+		AABB2TreeNode& node = m_nodes[nodeIndex];
+		AABB2 newBounds = MakeEmptyBounds_BVH();
+		if (node.m_leftChild < 0)
+		{
+			Convex2* const* prims = GetNodePrimitives(node);
+			for (int i = 0; i < node.m_numPrims; ++i)
+			{
+				GrowBounds_BVH(newBounds, prims[i]->m_boundingAABB);
+			}
+		}
+		else
+		{
+			AABB2TreeNode const& leftNode  = m_nodes[node.m_leftChild];
+			AABB2TreeNode const& rightNode = m_nodes[node.m_rightChild];
+			if (leftNode.m_numPrims > 0)  GrowBounds_BVH(newBounds, leftNode.m_bounds);
+			if (rightNode.m_numPrims > 0) GrowBounds_BVH(newBounds, rightNode.m_bounds);
+		}
+
+		// Ancestors only depend on this box, so an unchanged box ends the walk
+		if (newBounds.m_mins == node.m_bounds.m_mins && newBounds.m_maxs == node.m_bounds.m_maxs)
+		{
+			break;
+		}
+
+		m_currentCost -= GetNodeCost_BVH(node);
+		node.m_bounds  = newBounds;
+		m_currentCost += GetNodeCost_BVH(node);
+	}
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+float AABB2Tree::GetRefitCostRatio() const
+{
+	if (m_builtCost <= 0.f) return 1.f;
+	return m_currentCost / m_builtCost;
+}
+
+//----------------------------------------------------------------------------------------------------
+void AABB2Tree::SolveRayResult(Vec2 const& startPos, Vec2 const& forwardVec, float maxDist, std::vector<Convex2*>& out_latentRes) const
+{
+	if (m_buildMethod != eAABB2TreeBuildMethod::MIDPOINT)
+	{
+		SolveRayResultExplicit(startPos, forwardVec, maxDist, out_latentRes);
+		return;
+	}
+
+	RaySlab2D const ray(startPos, forwardVec, maxDist);
+
 	int ptr = 0;
 	while (ptr < static_cast<int>(m_nodes.size()))
 	{
-		if (RayHitsAABB2D_BVH(startPos, forwardVec, maxDist, m_nodes[ptr].m_bounds))
+		if (ray.HitsAABB2(m_nodes[ptr].m_bounds))
 		{
 			if (ptr >= m_startOfLastLevel)
 			{
-				for (auto convex : m_nodes[ptr].m_containingConvex)
-				{
-					out_latentRes.push_back(convex);
-				}
+				Convex2* const* prims = GetNodePrimitives(m_nodes[ptr]);
+				out_latentRes.insert(out_latentRes.end(), prims, prims + m_nodes[ptr].m_numPrims);
 				while (ptr % 2 == 0 && ptr != 0)
 				{
 					ptr = GetParentIndex(ptr);
@@ -171,7 +573,376 @@ void AABB2Tree::SolveRayResult(Vec2 const& startPos, Vec2 const& forwardVec, flo
 }
 
 //----------------------------------------------------------------------------------------------------
-int AABB2Tree::GetParentIndex(int index)
+// Stack walk over m_leftChild / m_rightChild for trees that are not in heap order
+//----------------------------------------------------------------------------------------------------
+void AABB2Tree::SolveRayResultExplicit(Vec2 const& startPos, Vec2 const& forwardVec, float maxDist, std::vector<Convex2*>& out_latentRes) const
+{
+	if (m_nodes.empty())
+	{
+		return;
+	}
+
+	RaySlab2D const ray(startPos, forwardVec, maxDist);
+
+	int stack[AABB2_TREE_STACK_SIZE];
+	int stackSize      = 0;
+	stack[stackSize++] = 0;
+
+	while (stackSize > 0)
+	{
+		AABB2TreeNode const& node = m_nodes[stack[--stackSize]];
+		if (!ray.HitsAABB2(node.m_bounds))
+		{
+			continue;
+		}
+
+		if (node.m_leftChild < 0)
+		{
+			Convex2* const* prims = GetNodePrimitives(node);
+			out_latentRes.insert(out_latentRes.end(), prims, prims + node.m_numPrims);
+		}
+		else
+		{
+			GUARANTEE_OR_DIE(stackSize + 2 <= AABB2_TREE_STACK_SIZE, "AABB2Tree deeper than MAX_AABB2_TREE_DEPTH");
+			stack[stackSize++] = node.m_rightChild;
+			stack[stackSize++] = node.m_leftChild;
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------
+Convex2* AABB2Tree::SolveRayClosestHit(Vec2 const& startPos, Vec2 const& forwardVec, float maxDist, RaycastResult2D& out_closestHit) const
+{
+	struct StackEntry
+	{
+		int   m_nodeIndex;
+		float m_entryDist;
+	};
+
+	out_closestHit.m_didImpact = false;
+	Convex2* closestConvex = nullptr;
+	float    bestDist      = maxDist;
+
+	if (m_nodes.empty())
+	{
+		return nullptr;
+	}
+
+	// m_maxDist follows bestDist, so boxes behind the best hit stop passing
+	RaySlab2D ray(startPos, forwardVec, bestDist);
+	float     rootEntryDist;
+	if (!ray.HitsAABB2(m_nodes[0].m_bounds, rootEntryDist))
+	{
+		return nullptr;
+	}
+
+	StackEntry stack[AABB2_TREE_STACK_SIZE];
+	int        stackSize = 0;
+	stack[stackSize++]   = { 0, rootEntryDist };
+
+	while (stackSize > 0)
+	{
+		StackEntry entry = stack[--stackSize];
+
+		// A closer hit was found after this node was pushed
+		if (entry.m_entryDist > bestDist)
+		{
+			continue;
+		}
+
+		AABB2TreeNode const& node = m_nodes[entry.m_nodeIndex];
+		if (node.m_leftChild < 0)
+		{
+			RaycastResult2D rayRes;
+			Convex2* const* prims = GetNodePrimitives(node);
+			for (int i = 0; i < node.m_numPrims; ++i)
+			{
+				Convex2* convex = prims[i];
+				if (convex->RayCastVsConvex2D<eRayRejection::DISC>(rayRes, ray) && rayRes.m_impactLength <= bestDist)
+				{
+					bestDist       = rayRes.m_impactLength;
+					ray.m_maxDist  = bestDist;
+					out_closestHit = rayRes;
+					closestConvex  = convex;
+				}
+			}
+			continue;
+		}
+
+		int leftChild  = node.m_leftChild;
+		int rightChild = node.m_rightChild;
+		float leftDist;
+		float rightDist;
+		bool  leftHit  = ray.HitsAABB2(m_nodes[leftChild].m_bounds, leftDist);
+		bool  rightHit = ray.HitsAABB2(m_nodes[rightChild].m_bounds, rightDist);
+
+		// Push the farther child first so the nearer one is popped next
+		GUARANTEE_OR_DIE(stackSize + 2 <= AABB2_TREE_STACK_SIZE, "AABB2Tree deeper than MAX_AABB2_TREE_DEPTH");
+		bool leftIsNearer = !rightHit || (leftHit && leftDist <= rightDist);
+		if (leftIsNearer)
+		{
+			if (rightHit) stack[stackSize++] = { rightChild, rightDist };
+			if (leftHit)  stack[stackSize++] = { leftChild, leftDist };
+		}
+		else
+		{
+			if (leftHit)  stack[stackSize++] = { leftChild, leftDist };
+			if (rightHit) stack[stackSize++] = { rightChild, rightDist };
+		}
+	}
+
+	return closestConvex;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Ray packets
+//----------------------------------------------------------------------------------------------------
+static float CrossProduct_BVH(Vec2 const& a, Vec2 const& b)
+{
+	return a.x * b.y - a.y * b.x;
+}
+
+//----------------------------------------------------------------------------------------------------
+void RayPacket2D::AddRay(Vec2 const& startPos, Vec2 const& forwardNormal, float maxDist)
+{
+	if (m_numRays >= MAX_RAY_PACKET_SIZE)
+	{
+		return;
+	}
+	m_startPos[m_numRays]      = startPos;
+	m_forwardNormal[m_numRays] = forwardNormal;
+	m_maxDist[m_numRays]       = maxDist;
+	++m_numRays;
+}
+
+//----------------------------------------------------------------------------------------------------
+void RayPacket2D::Prepare()
+{
+	m_hasFrustum = false;
+	if (m_numRays < 2)
+	{
+		return;
+	}
+
+	Vec2 sumForward;
+	for (int i = 0; i < m_numRays; ++i)
+	{
+		if (m_startPos[i] != m_startPos[0]) return;
+		sumForward += m_forwardNormal[i];
+	}
+	if (sumForward.GetLengthSquared() <= 0.f) return;
+	m_frustumAxis = sumForward.GetNormalized();
+
+	// Signed angle of each ray against the mean direction; more than 90 degrees either way means the
+	// wedge may reach 180 degrees, where two half-planes no longer bound it
+	m_frustumLeftEdge  = m_frustumAxis;
+	m_frustumRightEdge = m_frustumAxis;
+	m_frustumMaxDist   = 0.f;
+	float leftmostSin  = 0.f;
+	float rightmostSin = 0.f;
+	for (int i = 0; i < m_numRays; ++i)
+	{
+		Vec2 const& forward = m_forwardNormal[i];
+		if (forward.x * m_frustumAxis.x + forward.y * m_frustumAxis.y <= 0.f) return;
+
+		float sinToAxis = CrossProduct_BVH(m_frustumAxis, forward);
+		if (sinToAxis > leftmostSin)  { leftmostSin  = sinToAxis; m_frustumLeftEdge  = forward; }
+		if (sinToAxis < rightmostSin) { rightmostSin = sinToAxis; m_frustumRightEdge = forward; }
+		if (m_maxDist[i] > m_frustumMaxDist) m_frustumMaxDist = m_maxDist[i];
+	}
+	m_hasFrustum = true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Conservative: true only when the box is entirely outside one wedge edge or beyond the longest ray
+//----------------------------------------------------------------------------------------------------
+bool RayPacket2D::IsCulledByFrustum(AABB2 const& bounds) const
+{
+	if (!m_hasFrustum)
+	{
+		return false;
+	}
+
+	Vec2 const& origin = m_startPos[0];
+	Vec2 const  corners[4] = { bounds.m_mins - origin, Vec2(bounds.m_maxs.x, bounds.m_mins.y) - origin,
+	                           Vec2(bounds.m_mins.x, bounds.m_maxs.y) - origin, bounds.m_maxs - origin };
+
+	bool allLeftOfLeftEdge   = true;
+	bool allRightOfRightEdge = true;
+	for (Vec2 const& corner : corners)
+	{
+		if (CrossProduct_BVH(m_frustumLeftEdge, corner) <= 0.f)  allLeftOfLeftEdge   = false;
+		if (CrossProduct_BVH(m_frustumRightEdge, corner) >= 0.f) allRightOfRightEdge = false;
+	}
+	if (allLeftOfLeftEdge || allRightOfRightEdge)
+	{
+		return true;
+	}
+
+	float nearestX = (origin.x < bounds.m_mins.x) ? bounds.m_mins.x : ((origin.x > bounds.m_maxs.x) ? bounds.m_maxs.x : origin.x);
+	float nearestY = (origin.y < bounds.m_mins.y) ? bounds.m_mins.y : ((origin.y > bounds.m_maxs.y) ? bounds.m_maxs.y : origin.y);
+	Vec2  toNearest(nearestX - origin.x, nearestY - origin.y);
+	return toNearest.GetLengthSquared() > m_frustumMaxDist * m_frustumMaxDist;
+}
+
+//----------------------------------------------------------------------------------------------------
+void AABB2Tree::SolveRayPacketClosestHit(RayPacket2D const& packet, RaycastResult2D* out_closestHits, Convex2** out_closestConvexes) const
+{
+	struct StackEntry
+	{
+		int      m_nodeIndex;
+		uint32_t m_activeMask;
+	};
+
+	int const numRays = packet.m_numRays;
+	float     bestDist[MAX_RAY_PACKET_SIZE];
+	RaySlab2D rays[MAX_RAY_PACKET_SIZE];
+	for (int lane = 0; lane < numRays; ++lane)
+	{
+		out_closestHits[lane].m_didImpact = false;
+		out_closestConvexes[lane]         = nullptr;
+		bestDist[lane]                    = packet.m_maxDist[lane];
+		rays[lane]                        = RaySlab2D(packet.m_startPos[lane], packet.m_forwardNormal[lane], packet.m_maxDist[lane]);
+	}
+
+	if (m_nodes.empty() || numRays == 0)
+	{
+		return;
+	}
+
+	// Orders children near to far; any packet-wide direction works since it only affects speed
+	Vec2 axis = packet.m_hasFrustum ? packet.m_frustumAxis : packet.m_forwardNormal[0];
+
+	StackEntry stack[AABB2_TREE_STACK_SIZE];
+	int        stackSize = 0;
+	stack[stackSize++]   = { 0, (1u << numRays) - 1u };
+
+	while (stackSize > 0)
+	{
+		StackEntry           entry = stack[--stackSize];
+		AABB2TreeNode const& node  = m_nodes[entry.m_nodeIndex];
+		if (node.m_numPrims == 0 || packet.IsCulledByFrustum(node.m_bounds))
+		{
+			continue;
+		}
+
+		// Drop rays that miss this box or already hit something nearer than it
+		uint32_t activeMask = 0;
+		for (int lane = 0; lane < numRays; ++lane)
+		{
+			if ((entry.m_activeMask & (1u << lane)) != 0 && rays[lane].HitsAABB2(node.m_bounds))
+			{
+				activeMask |= (1u << lane);
+			}
+		}
+		if (activeMask == 0)
+		{
+			continue;
+		}
+
+		if (node.m_leftChild < 0)
+		{
+			RaycastResult2D rayRes;
+			Convex2* const* prims = GetNodePrimitives(node);
+			for (int lane = 0; lane < numRays; ++lane)
+			{
+				if ((activeMask & (1u << lane)) == 0) continue;
+				for (int i = 0; i < node.m_numPrims; ++i)
+				{
+					Convex2* convex = prims[i];
+					if (convex->RayCastVsConvex2D<eRayRejection::DISC>(rayRes, rays[lane]) && rayRes.m_impactLength <= bestDist[lane])
+					{
+						bestDist[lane]            = rayRes.m_impactLength;
+						rays[lane].m_maxDist      = bestDist[lane];
+						out_closestHits[lane]     = rayRes;
+						out_closestConvexes[lane] = convex;
+					}
+				}
+			}
+			continue;
+		}
+
+		// Push the child whose center lies farther along the packet direction first
+		Vec2 leftCenter   = m_nodes[node.m_leftChild].m_bounds.GetCenter();
+		Vec2 rightCenter  = m_nodes[node.m_rightChild].m_bounds.GetCenter();
+		bool leftIsNearer = (leftCenter.x * axis.x + leftCenter.y * axis.y) <= (rightCenter.x * axis.x + rightCenter.y * axis.y);
+		int  farChild     = leftIsNearer ? node.m_rightChild : node.m_leftChild;
+		int  nearChild    = leftIsNearer ? node.m_leftChild : node.m_rightChild;
+		GUARANTEE_OR_DIE(stackSize + 2 <= AABB2_TREE_STACK_SIZE, "AABB2Tree deeper than MAX_AABB2_TREE_DEPTH");
+		stack[stackSize++] = { farChild, activeMask };
+		stack[stackSize++] = { nearChild, activeMask };
+	}
+}
+
+//----------------------------------------------------------------------------------------------------
+// Point queries
+//----------------------------------------------------------------------------------------------------
+// Inclusive on every edge like IsPointInsideConvexHull2D, so a hull vertex lying on its box is not rejected
+//----------------------------------------------------------------------------------------------------
+static bool IsPointInBounds_BVH(Vec2 const& point, AABB2 const& bounds)
+{
+	return point.x >= bounds.m_mins.x && point.x <= bounds.m_maxs.x && point.y >= bounds.m_mins.y && point.y <= bounds.m_maxs.y;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Children are tested before they are pushed and the root is always opened: a midpoint build's root is
+// the world bounds it was given, which convexes near the edge may overhang.
+//----------------------------------------------------------------------------------------------------
+void AABB2Tree::SolvePointResult(Vec2 const& point, std::vector<Convex2*>& out_containing) const
+{
+	if (m_nodes.empty())
+	{
+		return;
+	}
+
+	int stack[AABB2_TREE_STACK_SIZE];
+	int stackSize      = 0;
+	stack[stackSize++] = 0;
+
+	while (stackSize > 0)
+	{
+		AABB2TreeNode const& node = m_nodes[stack[--stackSize]];
+		if (node.m_leftChild < 0)
+		{
+			Convex2* const* prims = GetNodePrimitives(node);
+			for (int i = 0; i < node.m_numPrims; ++i)
+			{
+				if (prims[i]->IsPointInside(point))
+				{
+					out_containing.push_back(prims[i]);
+				}
+			}
+			continue;
+		}
+
+		GUARANTEE_OR_DIE(stackSize + 2 <= AABB2_TREE_STACK_SIZE, "AABB2Tree deeper than MAX_AABB2_TREE_DEPTH");
+		if (IsPointInBounds_BVH(point, m_nodes[node.m_rightChild].m_bounds))
+		{
+			stack[stackSize++] = node.m_rightChild;
+		}
+		if (IsPointInBounds_BVH(point, m_nodes[node.m_leftChild].m_bounds))
+		{
+			stack[stackSize++] = node.m_leftChild;
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------
+void AABB2Tree::SolvePointBatch(Vec2 const* points, int const numPoints, std::vector<int>& out_firstContaining, std::vector<Convex2*>& out_containing) const
+{
+	out_firstContaining.clear();
+	out_containing.clear();
+	out_firstContaining.reserve(numPoints + 1);
+	for (int i = 0; i < numPoints; ++i)
+	{
+		out_firstContaining.push_back(static_cast<int>(out_containing.size()));
+		SolvePointResult(points[i], out_containing);
+	}
+	out_firstContaining.push_back(static_cast<int>(out_containing.size()));
+}
+
+//----------------------------------------------------------------------------------------------------
+int AABB2Tree::GetParentIndex(int index) const
 {
 	if (index % 2 == 0)
 	{
@@ -179,3 +950,256 @@ int AABB2Tree::GetParentIndex(int index)
 	}
 	return index >> 1;
 }
+
+//----------------------------------------------------------------------------------------------------
+// BVH4
+//----------------------------------------------------------------------------------------------------
+static void SetEmptySlot_BVH4(AABB2Tree4Node& node, int slot)
+{
+	node.m_minX[slot]      = FLT_MAX;
+	node.m_minY[slot]      = FLT_MAX;
+	node.m_maxX[slot]      = -FLT_MAX;
+	node.m_maxY[slot]      = -FLT_MAX;
+	node.m_child[slot]     = -1;
+	node.m_firstPrim[slot] = 0;
+	node.m_numPrims[slot]  = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Opens the largest inner node among the slots until there are four, then recurses into inner slots.
+// Empty binary subtrees (midpoint build) are dropped.
+//----------------------------------------------------------------------------------------------------
+static int CollapseNode_BVH4(std::vector<AABB2TreeNode> const& binaryNodes, std::vector<AABB2Tree4Node>& nodes, int binaryIndex)
+{
+	int slots[4] = { binaryIndex, -1, -1, -1 };
+	int numSlots = 1;
+
+	while (numSlots < 4)
+	{
+		int   openSlot    = -1;
+		float largestArea = -1.f;
+		for (int i = 0; i < numSlots; ++i)
+		{
+			AABB2TreeNode const& candidate = binaryNodes[slots[i]];
+			float area = GetHalfPerimeter_BVH(candidate.m_bounds);
+			if (candidate.m_leftChild >= 0 && area > largestArea)
+			{
+				openSlot    = i;
+				largestArea = area;
+			}
+		}
+		if (openSlot < 0)
+		{
+			break;
+		}
+
+		AABB2TreeNode const& opened = binaryNodes[slots[openSlot]];
+		slots[openSlot] = slots[--numSlots];
+		if (binaryNodes[opened.m_leftChild].m_numPrims > 0)  slots[numSlots++] = opened.m_leftChild;
+		if (binaryNodes[opened.m_rightChild].m_numPrims > 0) slots[numSlots++] = opened.m_rightChild;
+	}
+
+	int nodeIndex = static_cast<int>(nodes.size());
+	nodes.emplace_back();
+	for (int slot = 0; slot < 4; ++slot)
+	{
+		SetEmptySlot_BVH4(nodes[nodeIndex], slot);
+	}
+
+	for (int slot = 0; slot < numSlots; ++slot)
+	{
+		AABB2TreeNode const& binaryNode = binaryNodes[slots[slot]];
+		int child = -1;
+		if (binaryNode.m_leftChild >= 0)
+		{
+			child = CollapseNode_BVH4(binaryNodes, nodes, slots[slot]);
+		}
+
+		// Recursion may have reallocated nodes
+		AABB2Tree4Node& node   = nodes[nodeIndex];
+		node.m_minX[slot]      = binaryNode.m_bounds.m_mins.x;
+		node.m_minY[slot]      = binaryNode.m_bounds.m_mins.y;
+		node.m_maxX[slot]      = binaryNode.m_bounds.m_maxs.x;
+		node.m_maxY[slot]      = binaryNode.m_bounds.m_maxs.y;
+		node.m_child[slot]     = child;
+		node.m_firstPrim[slot] = binaryNode.m_firstPrim;
+		node.m_numPrims[slot]  = binaryNode.m_numPrims;
+	}
+	return nodeIndex;
+}
+
+//----------------------------------------------------------------------------------------------------
+void AABB2Tree4::BuildFromBinary(AABB2Tree const& binaryTree)
+{
+	m_nodes.clear();
+	m_primitives = binaryTree.m_primitives;
+
+	if (binaryTree.m_nodes.empty() || binaryTree.m_nodes[0].m_numPrims == 0)
+	{
+		return;
+	}
+
+	m_nodes.reserve(binaryTree.m_nodes.size() / 2 + 1);
+	CollapseNode_BVH4(binaryTree.m_nodes, m_nodes, 0);
+}
+
+//----------------------------------------------------------------------------------------------------
+void AABB2Tree4::SolveRayResult(Vec2 const& startPos, Vec2 const& forwardVec, float maxDist, std::vector<Convex2*>& out_latentRes) const
+{
+	if (m_nodes.empty())
+	{
+		return;
+	}
+
+	RaySlab2D const ray(startPos, forwardVec, maxDist);
+
+	int stack[AABB2_TREE4_STACK_SIZE];
+	int stackSize      = 0;
+	stack[stackSize++] = 0;
+
+	while (stackSize > 0)
+	{
+		AABB2Tree4Node const& node = m_nodes[stack[--stackSize]];
+
+		float entryDist[4];
+		int   hitMask = ray.HitsAABB2x4(node.m_minX, node.m_minY, node.m_maxX, node.m_maxY, entryDist);
+		for (int slot = 0; slot < 4; ++slot)
+		{
+			if ((hitMask & (1 << slot)) == 0)
+			{
+				continue;
+			}
+			if (node.m_child[slot] >= 0)
+			{
+				GUARANTEE_OR_DIE(stackSize < AABB2_TREE4_STACK_SIZE, "AABB2Tree4 deeper than MAX_AABB2_TREE_DEPTH");
+				stack[stackSize++] = node.m_child[slot];
+			}
+			else
+			{
+				Convex2* const* prims = m_primitives.data() + node.m_firstPrim[slot];
+				out_latentRes.insert(out_latentRes.end(), prims, prims + node.m_numPrims[slot]);
+			}
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------
+Convex2* AABB2Tree4::SolveRayClosestHit(Vec2 const& startPos, Vec2 const& forwardVec, float maxDist, RaycastResult2D& out_closestHit) const
+{
+	struct StackEntry
+	{
+		int   m_nodeIndex;
+		float m_entryDist;
+	};
+
+	out_closestHit.m_didImpact = false;
+	Convex2* closestConvex = nullptr;
+	float    bestDist      = maxDist;
+
+	if (m_nodes.empty())
+	{
+		return nullptr;
+	}
+
+	RaySlab2D ray(startPos, forwardVec, bestDist);
+
+	StackEntry stack[AABB2_TREE4_STACK_SIZE];
+	int        stackSize = 0;
+	stack[stackSize++]   = { 0, 0.f };
+
+	while (stackSize > 0)
+	{
+		StackEntry entry = stack[--stackSize];
+		if (entry.m_entryDist > bestDist)
+		{
+			continue;
+		}
+
+		AABB2Tree4Node const& node = m_nodes[entry.m_nodeIndex];
+
+		float entryDist[4];
+		int   hitMask = ray.HitsAABB2x4(node.m_minX, node.m_minY, node.m_maxX, node.m_maxY, entryDist);
+		if (hitMask == 0)
+		{
+			continue;
+		}
+
+		// Hit slots sorted near to far (insertion sort, at most four)
+		int order[4];
+		int numHits = 0;
+		for (int slot = 0; slot < 4; ++slot)
+		{
+			if ((hitMask & (1 << slot)) == 0) continue;
+			int i = numHits++;
+			while (i > 0 && entryDist[order[i - 1]] > entryDist[slot])
+			{
+				order[i] = order[i - 1];
+				--i;
+			}
+			order[i] = slot;
+		}
+
+		// Leaves are tested right away in near order, which shrinks bestDist before inner slots are pushed
+		int innerSlots[4];
+		int numInner = 0;
+		for (int i = 0; i < numHits; ++i)
+		{
+			int slot = order[i];
+			if (entryDist[slot] > bestDist)
+			{
+				break;
+			}
+			if (node.m_child[slot] >= 0)
+			{
+				innerSlots[numInner++] = slot;
+				continue;
+			}
+
+			RaycastResult2D rayRes;
+			Convex2* const* prims = m_primitives.data() + node.m_firstPrim[slot];
+			for (int p = 0; p < node.m_numPrims[slot]; ++p)
+			{
+				Convex2* convex = prims[p];
+				if (convex->RayCastVsConvex2D<eRayRejection::DISC>(rayRes, ray) && rayRes.m_impactLength <= bestDist)
+				{
+					bestDist       = rayRes.m_impactLength;
+					ray.m_maxDist  = bestDist;
+					out_closestHit = rayRes;
+					closestConvex  = convex;
+				}
+			}
+		}
+
+		// Push far to near so the nearest inner slot is popped next
+		for (int i = numInner - 1; i >= 0; --i)
+		{
+			int slot = innerSlots[i];
+			if (entryDist[slot] <= bestDist)
+			{
+				GUARANTEE_OR_DIE(stackSize < AABB2_TREE4_STACK_SIZE, "AABB2Tree4 deeper than MAX_AABB2_TREE_DEPTH");
+				stack[stackSize++] = { node.m_child[slot], entryDist[slot] };
+			}
+		}
+	}
+
+	return closestConvex;
+}
+
+//----------------------------------------------------------------------------------------------------
+size_t AABB2Tree4::GetMemoryFootprintBytes() const
+{
+	return m_nodes.capacity() * sizeof(AABB2Tree4Node) + m_primitives.capacity() * sizeof(Convex2*);
+}
+
+//----------------------------------------------------------------------------------------------------
+int GetDefaultAABB2TreeDepth(int numOfConvexes)
+{
+	if (numOfConvexes <= 0)
+	{
+		return 0;
+	}
+
+	int depth = static_cast<int>(log2(static_cast<double>(numOfConvexes))) - 3;
+	if (depth < 3) depth = 3;
+	return depth;
+}
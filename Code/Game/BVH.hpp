@@ -7,32 +7,180 @@
 //----------------------------------------------------------------------------------------------------
 #include "Engine/Math/AABB2.hpp"
 //----------------------------------------------------------------------------------------------------
+#include <cstdint>
+#include <unordered_map>
 #include <vector>
 
 //----------------------------------------------------------------------------------------------------
 struct Convex2;
+struct RaycastResult2D;
 struct Vec2;
 
+//----------------------------------------------------------------------------------------------------
+// AABB2TreeNode - 32 bytes, no per-node allocations. Convexes live in AABB2Tree::m_primitives, which the
+// build reorders so that every node's convexes form one contiguous range [m_firstPrim, +m_numPrims).
 //----------------------------------------------------------------------------------------------------
 struct AABB2TreeNode
 {
-	AABB2                  m_bounds;
-	std::vector<Convex2*>  m_containingConvex;
+	AABB2  m_bounds;
+	int    m_leftChild  = -1;   // -1 marks a leaf
+	int    m_rightChild = -1;
+	int    m_firstPrim  = 0;
+	int    m_numPrims   = 0;
+};
+static_assert(sizeof(AABB2TreeNode) == 32, "AABB2TreeNode should stay at 32 bytes (two nodes per cache line)");
+
+//----------------------------------------------------------------------------------------------------
+// MIDPOINT: complete binary tree of fixed depth in heap order (children of n at 2n+1, 2n+2), split at
+//           the spatial midpoint with x/y alternating per level; every node's range spans its descendants.
+// SAH:      binned surface-area-heuristic splits, variable leaf sizes, children stored explicitly and
+//           only leaves hold convexes.
+//----------------------------------------------------------------------------------------------------
+enum class eAABB2TreeBuildMethod : uint8_t
+{
+	MIDPOINT,
+	SAH
 };
 
+//----------------------------------------------------------------------------------------------------
+// RayPacket2D - Up to MAX_RAY_PACKET_SIZE rays traced through an AABB2Tree together. Add the rays, then
+// call Prepare(). When every ray starts at the same point and they span less than 180 degrees, Prepare
+// builds a wedge frustum (two edge rays plus the longest maxDist) that rejects a node for the whole
+// packet before any per-ray test.
+//----------------------------------------------------------------------------------------------------
+constexpr int MAX_RAY_PACKET_SIZE = 16;
+
+struct RayPacket2D
+{
+	void AddRay(Vec2 const& startPos, Vec2 const& forwardNormal, float maxDist);
+	void Prepare();
+	bool IsCulledByFrustum(AABB2 const& bounds) const;
+
+	int   m_numRays = 0;
+	Vec2  m_startPos[MAX_RAY_PACKET_SIZE];
+	Vec2  m_forwardNormal[MAX_RAY_PACKET_SIZE];
+	float m_maxDist[MAX_RAY_PACKET_SIZE];
+
+	bool  m_hasFrustum = false;
+	Vec2  m_frustumLeftEdge;    // Most counter-clockwise direction
+	Vec2  m_frustumRightEdge;   // Most clockwise direction
+	Vec2  m_frustumAxis;        // Mean direction, orders children near to far
+	float m_frustumMaxDist = 0.f;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Deepest AABB2Tree (root at depth 0) a build or SetLeafContents produces. Traversal stacks are sized
+// from it, so no query can run out of stack and skip a subtree.
+//----------------------------------------------------------------------------------------------------
+constexpr int MAX_AABB2_TREE_DEPTH = 64;
+
 //----------------------------------------------------------------------------------------------------
 class AABB2Tree
 {
 public:
 	void BuildTree(std::vector<Convex2*> const& convexArray, int numOfRecursive, AABB2 const& totalBounds);
-	void SolveRayResult(Vec2 const& startPos, Vec2 const& forwardVec, float maxDist, std::vector<Convex2*>& out_latentRes);
+	void BuildTreeSAH(std::vector<Convex2*> const& convexArray, int maxLeafSize = 4, int numOfBins = 16);
+	void SolveRayResult(Vec2 const& startPos, Vec2 const& forwardVec, float maxDist, std::vector<Convex2*>& out_latentRes) const;
+
+	// Raycasts leaf contents during traversal, visiting the nearer child first and shrinking maxDist
+	// to the best impact so far. Returns the hit convex (nullptr on miss) and fills out_closestHit.
+	Convex2* SolveRayClosestHit(Vec2 const& startPos, Vec2 const& forwardVec, float maxDist, RaycastResult2D& out_closestHit) const;
+
+	// Closest hit for every ray of a prepared packet with one shared traversal stack. Each stack entry
+	// carries the mask of rays still active in that subtree, so a node is fetched once per packet.
+	// out_closestHits and out_closestConvexes need packet.m_numRays entries (nullptr marks a miss).
+	void SolveRayPacketClosestHit(RayPacket2D const& packet, RaycastResult2D* out_closestHits, Convex2** out_closestConvexes) const;
+
+	// Appends every convex whose hull contains point. Only nodes whose bounds hold the point are opened,
+	// so the exact IsPointInside test runs on the few leaves under it rather than on every convex.
+	void SolvePointResult(Vec2 const& point, std::vector<Convex2*>& out_containing) const;
+
+	// SolvePointResult for numPoints points into shared CSR arrays (both cleared first): the convexes
+	// containing points[i] are out_containing[out_firstContaining[i], out_firstContaining[i + 1]).
+	void SolvePointBatch(Vec2 const* points, int numPoints, std::vector<int>& out_firstContaining, std::vector<Convex2*>& out_containing) const;
+
+	// Rebuilds m_primitives from per-leaf convex lists (indexed like m_nodes) once m_nodes holds bounds and
+	// children, e.g. after loading. Interior ranges are derived from their children. Returns false, leaving
+	// the ranges unset, when the children do not form a tree or it is deeper than MAX_AABB2_TREE_DEPTH.
+	bool SetLeafContents(std::vector<std::vector<Convex2*>> const& leafContents);
+
+	// Convexes referenced by node, i.e. m_primitives[m_firstPrim, m_firstPrim + m_numPrims)
+	Convex2* const* GetNodePrimitives(AABB2TreeNode const& node) const { return m_primitives.data() + node.m_firstPrim; }
+
+	// Heap bytes held by m_nodes, m_primitives and the refit bookkeeping (the convex map is estimated)
+	size_t GetMemoryFootprintBytes() const;
+
+	// Incremental update after convex moved, rotated or scaled: refits its leaf and walks up to the root,
+	// stopping early once a node's bounds no longer change. Leaf membership is not revisited, so the
+	// tree loosens over time; returns false when convex is not in the tree (a rebuild is needed).
+	bool RefitConvex(Convex2 const* convex);
+
+	// Sum of node half perimeters now vs right after the last build (1 = as built). A ray's expected
+	// traversal cost grows with this, so callers rebuild once it passes a threshold.
+	float GetRefitCostRatio() const;
 
 	std::vector<AABB2TreeNode> m_nodes;
+	std::vector<Convex2*>      m_primitives;
 
 	int  GetStartOfLastLevel() const { return m_startOfLastLevel; }
 	void SetStartOfLastLevel(int value) { m_startOfLastLevel = value; }
 
+	eAABB2TreeBuildMethod GetBuildMethod() const { return m_buildMethod; }
+	void                  SetBuildMethod(eAABB2TreeBuildMethod method) { m_buildMethod = method; }
+
 protected:
-	int GetParentIndex(int index);
-	int m_startOfLastLevel = 0;
+	int  GetParentIndex(int index) const;
+	void SolveRayResultExplicit(Vec2 const& startPos, Vec2 const& forwardVec, float maxDist, std::vector<Convex2*>& out_latentRes) const;
+	void InitRefitData();
+
+	int                   m_startOfLastLevel = 0;
+	eAABB2TreeBuildMethod m_buildMethod      = eAABB2TreeBuildMethod::MIDPOINT;
+
+	// Refit bookkeeping, filled by every build and by SetLeafContents
+	std::vector<int>                        m_parentIndices;    // -1 for the root
+	std::unordered_map<Convex2 const*, int> m_leafOfConvex;
+	float                                   m_builtCost   = 0.f;
+	float                                   m_currentCost = 0.f;
 };
+
+//----------------------------------------------------------------------------------------------------
+// AABB2Tree4Node - Four child boxes as SoA lanes so one RaySlab2D::HitsAABB2x4 call tests them all.
+// Slot i is an inner node when m_child[i] >= 0, otherwise a leaf over m_primitives[m_firstPrim[i],
+// +m_numPrims[i]). Unused slots hold an inverted box and never hit.
+//----------------------------------------------------------------------------------------------------
+struct alignas(16) AABB2Tree4Node
+{
+	float m_minX[4];
+	float m_minY[4];
+	float m_maxX[4];
+	float m_maxY[4];
+	int   m_child[4];
+	int   m_firstPrim[4];
+	int   m_numPrims[4];
+};
+
+//----------------------------------------------------------------------------------------------------
+// AABB2Tree4 - BVH4 collapsed from a built AABB2Tree: each node adopts up to four descendants of the
+// binary node, always opening the largest (half perimeter) inner one, so a traversal step tests four
+// boxes at once and the tree is about half as deep.
+//----------------------------------------------------------------------------------------------------
+class AABB2Tree4
+{
+public:
+	void BuildFromBinary(AABB2Tree const& binaryTree);
+	void SolveRayResult(Vec2 const& startPos, Vec2 const& forwardVec, float maxDist, std::vector<Convex2*>& out_latentRes) const;
+
+	// Same contract as AABB2Tree::SolveRayClosestHit; hit lanes are pushed far to near
+	Convex2* SolveRayClosestHit(Vec2 const& startPos, Vec2 const& forwardVec, float maxDist, RaycastResult2D& out_closestHit) const;
+
+	// Heap bytes held by m_nodes and m_primitives
+	size_t GetMemoryFootprintBytes() const;
+
+	std::vector<AABB2Tree4Node> m_nodes;
+	std::vector<Convex2*>       m_primitives;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Depth heuristic shared by the scene and the headless benchmark: log2(n) - 3, at least 3 levels
+//----------------------------------------------------------------------------------------------------
+int GetDefaultAABB2TreeDepth(int numOfConvexes);
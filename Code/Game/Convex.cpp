@@ -4,8 +4,13 @@
 
 //----------------------------------------------------------------------------------------------------
 #include "Game/Convex.hpp"
+#include "Game/ConvexPool.hpp"
+#include "Game/PlaneClip.hpp"
+#include "Game/RaySlab.hpp"
 #include "Engine/Math/RaycastUtils.hpp"
 #include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include <algorithm>
 #include <float.h>
 
 //----------------------------------------------------------------------------------------------------
@@ -41,8 +46,9 @@ Convex2::Convex2(ConvexHull2 const& convexHull2)
 //----------------------------------------------------------------------------------------------------
 Convex2::Convex2(std::vector<Vec2> const& vertices)
 	: m_convexPoly(ConvexPoly2(vertices))
-	, m_convexHull(ConvexHull2(m_convexPoly))
 {
+	// m_convexHull is declared (and so initialized) before m_convexPoly, so it is built here instead
+	m_convexHull = ConvexHull2(m_convexPoly);
 	RebuildBoundingVolumes();
 }
 
@@ -160,41 +166,74 @@ bool Convex2::IsPointInside(Vec2 const& point) const
 //----------------------------------------------------------------------------------------------------
 bool Convex2::RayCastVsConvex2D(RaycastResult2D& out_rayCastRes, Vec2 const& startPos, Vec2 const& forwardNormal, float maxDist, bool discRejection, bool boxRejection)
 {
-	if (discRejection)
-	{
-		Vec2 startToCenter = m_boundingDiscCenter - startPos;
-		float distSqToCenter = startToCenter.GetLengthSquared();
-		bool startInsideDisc = (distSqToCenter < m_boundingRadius * m_boundingRadius);
+	return RayCastVsConvex2D(out_rayCastRes, RaySlab2D(startPos, forwardNormal, maxDist), discRejection, boxRejection);
+}
 
-		if (startInsideDisc)
-		{
-			out_rayCastRes = RaycastVsConvexHull2D(startPos, forwardNormal, maxDist, m_convexHull);
-			return out_rayCastRes.m_didImpact;
-		}
+//----------------------------------------------------------------------------------------------------
+bool Convex2::RayCastVsConvex2D(RaycastResult2D& out_rayCastRes, RaySlab2D const& ray, bool discRejection, bool boxRejection)
+{
+	if (discRejection) return RayCastVsConvex2D<eRayRejection::DISC>(out_rayCastRes, ray);
+	if (boxRejection)  return RayCastVsConvex2D<eRayRejection::AABB>(out_rayCastRes, ray);
+	return RayCastVsConvex2D<eRayRejection::NONE>(out_rayCastRes, ray);
+}
 
-		RaycastResult2D discResult = RaycastVsDisc2D(startPos, forwardNormal, maxDist, m_boundingDiscCenter, m_boundingRadius);
-		if (discResult.m_didImpact)
-		{
-			out_rayCastRes = RaycastVsConvexHull2D(startPos, forwardNormal, maxDist, m_convexHull);
-			return out_rayCastRes.m_didImpact;
-		}
-		out_rayCastRes.m_didImpact = false;
-		return false;
+//----------------------------------------------------------------------------------------------------
+// The rejection tests only need "can it hit", so they use the prepared ray instead of RaycastVsDisc2D /
+// RaycastVsAABB2D, which divide per call and build an impact that is thrown away.
+//----------------------------------------------------------------------------------------------------
+template <eRayRejection REJECTION>
+bool Convex2::RayCastVsConvex2D(RaycastResult2D& out_rayCastRes, RaySlab2D const& ray)
+{
+	bool mayHit = true;
+	if constexpr (REJECTION == eRayRejection::DISC)
+	{
+		mayHit = ray.HitsDisc2(m_boundingDiscCenter, m_boundingRadius);
 	}
-	else if (boxRejection)
+	else if constexpr (REJECTION == eRayRejection::AABB)
+	{
+		mayHit = ray.HitsAABB2(m_boundingAABB);
+	}
+	if (!mayHit)
 	{
-		Vec2 aabb2Mins = m_boundingAABB.m_mins;
-		Vec2 aabb2Maxs = m_boundingAABB.m_maxs;
-		RaycastResult2D aabbResult = RaycastVsAABB2D(startPos, forwardNormal, maxDist, aabb2Mins, aabb2Maxs);
-		if (aabbResult.m_didImpact)
-		{
-			out_rayCastRes = RaycastVsConvexHull2D(startPos, forwardNormal, maxDist, m_convexHull);
-			return out_rayCastRes.m_didImpact;
-		}
 		out_rayCastRes.m_didImpact = false;
 		return false;
 	}
 
-	out_rayCastRes = RaycastVsConvexHull2D(startPos, forwardNormal, maxDist, m_convexHull);
-	return out_rayCastRes.m_didImpact;
+	std::vector<Plane2> const& planes = m_convexHull.m_boundingPlanes;
+	return RaycastVsPlanes2D(ray, planes.data(), static_cast<int>(planes.size()), out_rayCastRes);
+}
+
+template bool Convex2::RayCastVsConvex2D<eRayRejection::NONE>(RaycastResult2D& out_rayCastRes, RaySlab2D const& ray);
+template bool Convex2::RayCastVsConvex2D<eRayRejection::DISC>(RaycastResult2D& out_rayCastRes, RaySlab2D const& ray);
+template bool Convex2::RayCastVsConvex2D<eRayRejection::AABB>(RaycastResult2D& out_rayCastRes, RaySlab2D const& ray);
+
+//----------------------------------------------------------------------------------------------------
+// CreateRandomConvex2 - Jittered polar vertices around center, sorted by angle to stay convex. Angles
+// live on the stack and the vertex list is sized once, so the only heap blocks are the convex's own.
+//----------------------------------------------------------------------------------------------------
+Convex2* CreateRandomConvex2(ConvexPool& pool, RandomNumberGenerator& rng, Vec2 const& center, float minRadius, float maxRadius, int numSides)
+{
+	if (numSides < MIN_RANDOM_CONVEX_SIDES || numSides > MAX_RANDOM_CONVEX_SIDES)
+	{
+		numSides = rng.RollRandomIntInRange(MIN_RANDOM_CONVEX_SIDES, MAX_RANDOM_CONVEX_SIDES);
+	}
+	float radius = rng.RollRandomFloatInRange(minRadius, maxRadius);
+
+	float angleStep = 360.f / static_cast<float>(numSides);
+	float angles[MAX_RANDOM_CONVEX_SIDES];
+	for (int i = 0; i < numSides; ++i)
+	{
+		float baseAngle      = angleStep * static_cast<float>(i);
+		float angleVariation = rng.RollRandomFloatInRange(-angleStep * 0.3f, angleStep * 0.3f);
+		angles[i] = baseAngle + angleVariation;
+	}
+	std::sort(angles, angles + numSides);
+
+	std::vector<Vec2> vertices(numSides);
+	for (int i = 0; i < numSides; ++i)
+	{
+		vertices[i] = center + Vec2::MakeFromPolarDegrees(angles[i], radius);
+	}
+
+	return pool.Create(vertices);
 }
@@ -7,11 +7,26 @@
 #include "Engine/Math/ConvexHull2.hpp"
 #include "Engine/Math/AABB2.hpp"
 #include "Engine/Math/Vec2.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <cstdint>
 
 //----------------------------------------------------------------------------------------------------
 // Forward Declarations
 //----------------------------------------------------------------------------------------------------
 struct RaycastResult2D;
+struct RaySlab2D;
+class ConvexPool;
+class RandomNumberGenerator;
+
+//----------------------------------------------------------------------------------------------------
+// Bounding volume tested before the hull planes; fixed per call site by RayCastVsConvex2D<REJECTION>
+//----------------------------------------------------------------------------------------------------
+enum class eRayRejection : uint8_t
+{
+	NONE,
+	DISC,
+	AABB
+};
 
 //----------------------------------------------------------------------------------------------------
 // Convex2 - 2D Convex Polygon with dual representation
@@ -35,6 +50,11 @@ public:
 	//------------------------------------------------------------------------------------------------
 	bool IsPointInside(Vec2 const& point) const;
 	bool RayCastVsConvex2D(RaycastResult2D& out_rayCastRes, Vec2 const& startPos, Vec2 const& forwardNormal, float maxDist, bool discRejection = true, bool boxRejection = false);
+	// Same test for a ray prepared once by the caller; ray.m_maxDist is the max distance
+	bool RayCastVsConvex2D(RaycastResult2D& out_rayCastRes, RaySlab2D const& ray, bool discRejection = true, bool boxRejection = false);
+	// Inner-loop form: the rejection test is chosen at compile time, then the hull planes are clipped by RaycastVsPlanes2D
+	template <eRayRejection REJECTION>
+	bool RayCastVsConvex2D(RaycastResult2D& out_rayCastRes, RaySlab2D const& ray);
 
 	//------------------------------------------------------------------------------------------------
 	// Transform Methods
@@ -54,5 +74,13 @@ public:
 	Vec2        m_boundingDiscCenter;      // Bounding disc center
 	float       m_boundingRadius = 0.f;    // Bounding disc radius
 	float       m_scale = 1.f;             // Current scale factor
-	bool        m_symmetricQuadTreeFlag = false; // For QuadTree deduplication
 };
+
+//----------------------------------------------------------------------------------------------------
+// CreateRandomConvex2 - Random 3-8 sided convex around center, allocated from pool (which owns it).
+// numSides outside that range (the default) rolls a random side count.
+//----------------------------------------------------------------------------------------------------
+constexpr int MIN_RANDOM_CONVEX_SIDES = 3;
+constexpr int MAX_RANDOM_CONVEX_SIDES = 8;
+
+Convex2* CreateRandomConvex2(ConvexPool& pool, RandomNumberGenerator& rng, Vec2 const& center, float minRadius, float maxRadius, int numSides = 0);
@@ -0,0 +1,147 @@
+//----------------------------------------------------------------------------------------------------
+// ConvexPool.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/ConvexPool.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Game/Convex.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <new>
+
+//----------------------------------------------------------------------------------------------------
+// Storage comes first so a Convex2* and its Slot* share an address
+//----------------------------------------------------------------------------------------------------
+struct ConvexPool::Slot
+{
+	alignas(Convex2) unsigned char m_storage[sizeof(Convex2)];
+	Slot* m_nextFree = nullptr;
+	bool  m_isLive   = false;
+
+	Convex2* GetConvex() { return reinterpret_cast<Convex2*>(m_storage); }
+};
+
+//----------------------------------------------------------------------------------------------------
+ConvexPool::ConvexPool(ConvexPool&& other) noexcept
+	: m_blocks(std::move(other.m_blocks))
+	, m_freeList(other.m_freeList)
+	, m_numLive(other.m_numLive)
+	, m_numBlockAllocations(other.m_numBlockAllocations)
+{
+	other.m_blocks.clear();
+	other.m_freeList = nullptr;
+	other.m_numLive  = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+ConvexPool& ConvexPool::operator=(ConvexPool&& other) noexcept
+{
+	if (this != &other)
+	{
+		ReleaseAll();
+		m_blocks              = std::move(other.m_blocks);
+		m_freeList            = other.m_freeList;
+		m_numLive             = other.m_numLive;
+		m_numBlockAllocations = other.m_numBlockAllocations;
+
+		other.m_blocks.clear();
+		other.m_freeList = nullptr;
+		other.m_numLive  = 0;
+	}
+	return *this;
+}
+
+//----------------------------------------------------------------------------------------------------
+ConvexPool::~ConvexPool()
+{
+	ReleaseAll();
+}
+
+//----------------------------------------------------------------------------------------------------
+Convex2* ConvexPool::Create()
+{
+	return new (AcquireSlot()->m_storage) Convex2();
+}
+
+//----------------------------------------------------------------------------------------------------
+Convex2* ConvexPool::Create(ConvexPoly2 const& convexPoly2)
+{
+	return new (AcquireSlot()->m_storage) Convex2(convexPoly2);
+}
+
+//----------------------------------------------------------------------------------------------------
+Convex2* ConvexPool::Create(std::vector<Vec2> const& vertices)
+{
+	return new (AcquireSlot()->m_storage) Convex2(vertices);
+}
+
+//----------------------------------------------------------------------------------------------------
+void ConvexPool::Destroy(Convex2* convex)
+{
+	if (convex == nullptr) return;
+
+	Slot* slot = reinterpret_cast<Slot*>(convex);
+	convex->~Convex2();
+	slot->m_isLive   = false;
+	slot->m_nextFree = m_freeList;
+	m_freeList       = slot;
+	--m_numLive;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Slots are pushed back to front so the next creates fill each block in address order again
+//----------------------------------------------------------------------------------------------------
+void ConvexPool::Reset()
+{
+	m_freeList = nullptr;
+	for (int b = static_cast<int>(m_blocks.size()) - 1; b >= 0; --b)
+	{
+		for (int s = CONVEX_POOL_BLOCK_SIZE - 1; s >= 0; --s)
+		{
+			Slot& slot = m_blocks[b][s];
+			if (slot.m_isLive)
+			{
+				slot.GetConvex()->~Convex2();
+				slot.m_isLive = false;
+			}
+			slot.m_nextFree = m_freeList;
+			m_freeList      = &slot;
+		}
+	}
+	m_numLive = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+ConvexPool::Slot* ConvexPool::AcquireSlot()
+{
+	if (m_freeList == nullptr)
+	{
+		Slot* block = new Slot[CONVEX_POOL_BLOCK_SIZE];
+		m_blocks.push_back(block);
+		++m_numBlockAllocations;
+
+		for (int s = CONVEX_POOL_BLOCK_SIZE - 1; s >= 0; --s)
+		{
+			block[s].m_nextFree = m_freeList;
+			m_freeList          = &block[s];
+		}
+	}
+
+	Slot* slot     = m_freeList;
+	m_freeList     = slot->m_nextFree;
+	slot->m_isLive = true;
+	++m_numLive;
+	return slot;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ConvexPool::ReleaseAll()
+{
+	Reset();
+	for (Slot* block : m_blocks)
+	{
+		delete[] block;
+	}
+	m_blocks.clear();
+	m_freeList = nullptr;
+}
@@ -0,0 +1,56 @@
+//----------------------------------------------------------------------------------------------------
+// ConvexPool.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include "Engine/Math/Vec2.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+struct Convex2;
+struct ConvexPoly2;
+
+//----------------------------------------------------------------------------------------------------
+// ConvexPool - Scene-owned storage for Convex2 objects.
+//
+// Convexes are constructed in place in blocks of CONVEX_POOL_BLOCK_SIZE slots instead of one `new` each.
+// Destroy returns a slot to a free list; Reset destroys every live convex but keeps the blocks, so
+// clearing and refilling a scene reuses the same memory. Moving a pool keeps its Convex2 pointers valid.
+// The vertex and plane vectors inside ConvexPoly2 / ConvexHull2 are Engine types and still allocate
+// per convex.
+//----------------------------------------------------------------------------------------------------
+constexpr int CONVEX_POOL_BLOCK_SIZE = 256;
+
+class ConvexPool
+{
+public:
+	ConvexPool() = default;
+	ConvexPool(ConvexPool&& other) noexcept;
+	ConvexPool& operator=(ConvexPool&& other) noexcept;
+	ConvexPool(ConvexPool const&)            = delete;
+	ConvexPool& operator=(ConvexPool const&) = delete;
+	~ConvexPool();
+
+	Convex2* Create();
+	Convex2* Create(ConvexPoly2 const& convexPoly2);
+	Convex2* Create(std::vector<Vec2> const& vertices);
+	void     Destroy(Convex2* convex);
+	void     Reset();
+
+	int GetNumLiveConvexes() const { return m_numLive; }
+	int GetNumBlocks() const { return static_cast<int>(m_blocks.size()); }
+	int GetNumBlockAllocations() const { return m_numBlockAllocations; }   // Since construction (moves carry it over)
+
+private:
+	struct Slot;
+
+	Slot* AcquireSlot();
+	void  ReleaseAll();
+
+	std::vector<Slot*> m_blocks;
+	Slot*              m_freeList            = nullptr;
+	int                m_numLive             = 0;
+	int                m_numBlockAllocations = 0;
+};
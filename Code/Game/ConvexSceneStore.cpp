@@ -0,0 +1,282 @@
+//----------------------------------------------------------------------------------------------------
+// ConvexSceneStore.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/ConvexSceneStore.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Game/Convex.hpp"
+#include "Game/PlaneClip.hpp"
+#include "Game/RaySlab.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Math/RaycastUtils.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <algorithm>
+//----------------------------------------------------------------------------------------------------
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+//----------------------------------------------------------------------------------------------------
+void ConvexSceneStore::Build(std::vector<Convex2*> const& convexArray)
+{
+	int const numConvexes = static_cast<int>(convexArray.size());
+
+	m_discCenterX.resize(numConvexes);
+	m_discCenterY.resize(numConvexes);
+	m_discRadius.resize(numConvexes);
+	m_aabbMinX.resize(numConvexes);
+	m_aabbMinY.resize(numConvexes);
+	m_aabbMaxX.resize(numConvexes);
+	m_aabbMaxY.resize(numConvexes);
+	m_firstPlane.resize(numConvexes + 1);
+	m_planes.clear();
+
+	for (int i = 0; i < numConvexes; ++i)
+	{
+		Convex2 const* convex = convexArray[i];
+		WriteBoundingVolumes(i, *convex);
+
+		m_firstPlane[i] = static_cast<int>(m_planes.size());
+		m_planes.insert(m_planes.end(), convex->m_convexHull.m_boundingPlanes.begin(), convex->m_convexHull.m_boundingPlanes.end());
+	}
+	m_firstPlane[numConvexes] = static_cast<int>(m_planes.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ConvexSceneStore::UpdateConvex(int const index, Convex2 const& convex)
+{
+	if (index < 0 || index >= GetNumConvexes()) return false;
+
+	std::vector<Plane2> const& planes = convex.m_convexHull.m_boundingPlanes;
+	if (static_cast<int>(planes.size()) != m_firstPlane[index + 1] - m_firstPlane[index]) return false;
+
+	WriteBoundingVolumes(index, convex);
+	std::copy(planes.begin(), planes.end(), m_planes.begin() + m_firstPlane[index]);
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ConvexSceneStore::WriteBoundingVolumes(int const index, Convex2 const& convex)
+{
+	m_discCenterX[index] = convex.m_boundingDiscCenter.x;
+	m_discCenterY[index] = convex.m_boundingDiscCenter.y;
+	m_discRadius[index]  = convex.m_boundingRadius;
+	m_aabbMinX[index]    = convex.m_boundingAABB.m_mins.x;
+	m_aabbMinY[index]    = convex.m_boundingAABB.m_mins.y;
+	m_aabbMaxX[index]    = convex.m_boundingAABB.m_maxs.x;
+	m_aabbMaxY[index]    = convex.m_boundingAABB.m_maxs.y;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ConvexSceneStore::RaycastConvex(int const index, RaySlab2D const& ray, RaycastResult2D& out_rayCastRes) const
+{
+	int const firstPlane = m_firstPlane[index];
+	return RaycastVsPlanes2D(ray, m_planes.data() + firstPlane, m_firstPlane[index + 1] - firstPlane, out_rayCastRes);
+}
+
+//----------------------------------------------------------------------------------------------------
+int ConvexSceneStore::RaycastClosest(Vec2 const& startPos, Vec2 const& forwardNormal, float const maxDist, bool const discRejection, bool const boxRejection, RaycastResult2D& out_closestHit) const
+{
+	RaySlab2D const ray(startPos, forwardNormal, maxDist);
+	RaycastResult2D rayRes;
+	int closestIndex = -1;
+	out_closestHit.m_didImpact = false;
+
+	int const numConvexes = GetNumConvexes();
+	for (int i = 0; i < numConvexes; ++i)
+	{
+		if (discRejection)
+		{
+			// Closest point of the ray segment to the disc center; the hull lies inside the disc
+			float const toCenterX = m_discCenterX[i] - startPos.x;
+			float const toCenterY = m_discCenterY[i] - startPos.y;
+			float       along     = toCenterX * forwardNormal.x + toCenterY * forwardNormal.y;
+			along = (along < 0.f) ? 0.f : ((along > maxDist) ? maxDist : along);
+
+			float const offsetX = toCenterX - forwardNormal.x * along;
+			float const offsetY = toCenterY - forwardNormal.y * along;
+			if (offsetX * offsetX + offsetY * offsetY > m_discRadius[i] * m_discRadius[i]) continue;
+		}
+		else if (boxRejection)
+		{
+			AABB2 const bounds(Vec2(m_aabbMinX[i], m_aabbMinY[i]), Vec2(m_aabbMaxX[i], m_aabbMaxY[i]));
+			if (!ray.HitsAABB2(bounds)) continue;
+		}
+
+		if (RaycastConvex(i, ray, rayRes) &&
+			(closestIndex < 0 || rayRes.m_impactLength < out_closestHit.m_impactLength))
+		{
+			out_closestHit = rayRes;
+			closestIndex   = i;
+		}
+	}
+	return closestIndex;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Appends the lanes set in hitMask as base + lane. Every lane is written and the count only advances for
+// hits, so the compaction has no branches; the count never passes base, so the writes stay in bounds.
+//----------------------------------------------------------------------------------------------------
+static int AppendSurvivors_CSS(int const hitMask, int const numLanes, int const base, int* out_survivors, int numSurvivors)
+{
+	for (int lane = 0; lane < numLanes; ++lane)
+	{
+		out_survivors[numSurvivors] = base + lane;
+		numSurvivors += (hitMask >> lane) & 1;
+	}
+	return numSurvivors;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Same test as the disc branch of RaycastClosest: clamp the center's projection onto the ray segment
+// and compare the squared offset with the squared radius.
+//----------------------------------------------------------------------------------------------------
+int ConvexSceneStore::GatherDiscSurvivors(Vec2 const& startPos, Vec2 const& forwardNormal, float const maxDist, std::vector<int>& out_survivors) const
+{
+	int const numConvexes = GetNumConvexes();
+	out_survivors.resize(numConvexes);
+	int* survivors    = out_survivors.data();
+	int  numSurvivors = 0;
+	int  i            = 0;
+
+#if defined(__AVX2__)
+	__m256 const startX8  = _mm256_set1_ps(startPos.x);
+	__m256 const startY8  = _mm256_set1_ps(startPos.y);
+	__m256 const fwdX8    = _mm256_set1_ps(forwardNormal.x);
+	__m256 const fwdY8    = _mm256_set1_ps(forwardNormal.y);
+	__m256 const maxDist8 = _mm256_set1_ps(maxDist);
+	for (; i + 8 <= numConvexes; i += 8)
+	{
+		__m256 toCenterX = _mm256_sub_ps(_mm256_loadu_ps(&m_discCenterX[i]), startX8);
+		__m256 toCenterY = _mm256_sub_ps(_mm256_loadu_ps(&m_discCenterY[i]), startY8);
+		__m256 along     = _mm256_add_ps(_mm256_mul_ps(toCenterX, fwdX8), _mm256_mul_ps(toCenterY, fwdY8));
+		along = _mm256_min_ps(_mm256_max_ps(along, _mm256_setzero_ps()), maxDist8);
+
+		__m256 offsetX = _mm256_sub_ps(toCenterX, _mm256_mul_ps(fwdX8, along));
+		__m256 offsetY = _mm256_sub_ps(toCenterY, _mm256_mul_ps(fwdY8, along));
+		__m256 radius  = _mm256_loadu_ps(&m_discRadius[i]);
+		__m256 isHit   = _mm256_cmp_ps(_mm256_add_ps(_mm256_mul_ps(offsetX, offsetX), _mm256_mul_ps(offsetY, offsetY)), _mm256_mul_ps(radius, radius), _CMP_LE_OQ);
+		numSurvivors = AppendSurvivors_CSS(_mm256_movemask_ps(isHit), 8, i, survivors, numSurvivors);
+	}
+#endif
+#if defined(RAY_SLAB_SSE2)
+	__m128 const startX4  = _mm_set1_ps(startPos.x);
+	__m128 const startY4  = _mm_set1_ps(startPos.y);
+	__m128 const fwdX4    = _mm_set1_ps(forwardNormal.x);
+	__m128 const fwdY4    = _mm_set1_ps(forwardNormal.y);
+	__m128 const maxDist4 = _mm_set1_ps(maxDist);
+	for (; i + 4 <= numConvexes; i += 4)
+	{
+		__m128 toCenterX = _mm_sub_ps(_mm_loadu_ps(&m_discCenterX[i]), startX4);
+		__m128 toCenterY = _mm_sub_ps(_mm_loadu_ps(&m_discCenterY[i]), startY4);
+		__m128 along     = _mm_add_ps(_mm_mul_ps(toCenterX, fwdX4), _mm_mul_ps(toCenterY, fwdY4));
+		along = _mm_min_ps(_mm_max_ps(along, _mm_setzero_ps()), maxDist4);
+
+		__m128 offsetX = _mm_sub_ps(toCenterX, _mm_mul_ps(fwdX4, along));
+		__m128 offsetY = _mm_sub_ps(toCenterY, _mm_mul_ps(fwdY4, along));
+		__m128 radius  = _mm_loadu_ps(&m_discRadius[i]);
+		__m128 isHit   = _mm_cmple_ps(_mm_add_ps(_mm_mul_ps(offsetX, offsetX), _mm_mul_ps(offsetY, offsetY)), _mm_mul_ps(radius, radius));
+		numSurvivors = AppendSurvivors_CSS(_mm_movemask_ps(isHit), 4, i, survivors, numSurvivors);
+	}
+#endif
+	for (; i < numConvexes; ++i)
+	{
+		float const toCenterX = m_discCenterX[i] - startPos.x;
+		float const toCenterY = m_discCenterY[i] - startPos.y;
+		float       along     = toCenterX * forwardNormal.x + toCenterY * forwardNormal.y;
+		along = (along < 0.f) ? 0.f : ((along > maxDist) ? maxDist : along);
+
+		float const offsetX = toCenterX - forwardNormal.x * along;
+		float const offsetY = toCenterY - forwardNormal.y * along;
+		int const   isHit   = (offsetX * offsetX + offsetY * offsetY <= m_discRadius[i] * m_discRadius[i]) ? 1 : 0;
+		numSurvivors = AppendSurvivors_CSS(isHit, 1, i, survivors, numSurvivors);
+	}
+	return numSurvivors;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Slab test over the AABB arrays with the ray's safe reciprocal from RaySlab2D
+//----------------------------------------------------------------------------------------------------
+int ConvexSceneStore::GatherAABBSurvivors(Vec2 const& startPos, Vec2 const& forwardNormal, float const maxDist, std::vector<int>& out_survivors) const
+{
+	RaySlab2D const ray(startPos, forwardNormal, maxDist);
+
+	int const numConvexes = GetNumConvexes();
+	out_survivors.resize(numConvexes);
+	int* survivors    = out_survivors.data();
+	int  numSurvivors = 0;
+	int  i            = 0;
+
+#if defined(__AVX2__)
+	__m256 const startX8  = _mm256_set1_ps(ray.m_startPos.x);
+	__m256 const startY8  = _mm256_set1_ps(ray.m_startPos.y);
+	__m256 const invX8    = _mm256_set1_ps(ray.m_invForward.x);
+	__m256 const invY8    = _mm256_set1_ps(ray.m_invForward.y);
+	__m256 const maxDist8 = _mm256_set1_ps(maxDist);
+	for (; i + 8 <= numConvexes; i += 8)
+	{
+		__m256 tx1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(&m_aabbMinX[i]), startX8), invX8);
+		__m256 tx2 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(&m_aabbMaxX[i]), startX8), invX8);
+		__m256 ty1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(&m_aabbMinY[i]), startY8), invY8);
+		__m256 ty2 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(&m_aabbMaxY[i]), startY8), invY8);
+
+		__m256 tEnter = _mm256_max_ps(_mm256_max_ps(_mm256_min_ps(tx1, tx2), _mm256_min_ps(ty1, ty2)), _mm256_setzero_ps());
+		__m256 tExit  = _mm256_min_ps(_mm256_min_ps(_mm256_max_ps(tx1, tx2), _mm256_max_ps(ty1, ty2)), maxDist8);
+		numSurvivors = AppendSurvivors_CSS(_mm256_movemask_ps(_mm256_cmp_ps(tEnter, tExit, _CMP_LE_OQ)), 8, i, survivors, numSurvivors);
+	}
+#endif
+#if defined(RAY_SLAB_SSE2)
+	for (; i + 4 <= numConvexes; i += 4)
+	{
+		float entryDist[4];
+		int hitMask = ray.HitsAABB2x4(&m_aabbMinX[i], &m_aabbMinY[i], &m_aabbMaxX[i], &m_aabbMaxY[i], entryDist);
+		numSurvivors = AppendSurvivors_CSS(hitMask, 4, i, survivors, numSurvivors);
+	}
+#endif
+	for (; i < numConvexes; ++i)
+	{
+		AABB2 const bounds(Vec2(m_aabbMinX[i], m_aabbMinY[i]), Vec2(m_aabbMaxX[i], m_aabbMaxY[i]));
+		numSurvivors = AppendSurvivors_CSS(ray.HitsAABB2(bounds) ? 1 : 0, 1, i, survivors, numSurvivors);
+	}
+	return numSurvivors;
+}
+
+//----------------------------------------------------------------------------------------------------
+int ConvexSceneStore::RaycastClosestSwept(Vec2 const& startPos, Vec2 const& forwardNormal, float const maxDist, bool const discRejection, std::vector<int>& scratchSurvivors, RaycastResult2D& out_closestHit) const
+{
+	int const numSurvivors = discRejection ? GatherDiscSurvivors(startPos, forwardNormal, maxDist, scratchSurvivors)
+	                                       : GatherAABBSurvivors(startPos, forwardNormal, maxDist, scratchSurvivors);
+
+	RaySlab2D const ray(startPos, forwardNormal, maxDist);
+	RaycastResult2D rayRes;
+	int closestIndex = -1;
+	out_closestHit.m_didImpact = false;
+
+	for (int s = 0; s < numSurvivors; ++s)
+	{
+		int const index = scratchSurvivors[s];
+		if (RaycastConvex(index, ray, rayRes) &&
+			(closestIndex < 0 || rayRes.m_impactLength < out_closestHit.m_impactLength))
+		{
+			out_closestHit = rayRes;
+			closestIndex   = index;
+		}
+	}
+	return closestIndex;
+}
+
+//----------------------------------------------------------------------------------------------------
+size_t ConvexSceneStore::GetMemoryFootprintBytes() const
+{
+	size_t const numConvexes = m_discRadius.size();
+	return numConvexes * 7 * sizeof(float) + m_planes.size() * sizeof(Plane2) + m_firstPlane.size() * sizeof(int);
+}
+
+//----------------------------------------------------------------------------------------------------
+size_t ConvexSceneStore::GetConvexFootprintBytes(Convex2 const& convex)
+{
+	return sizeof(Convex2*) + sizeof(Convex2) +
+		convex.m_convexHull.m_boundingPlanes.size() * sizeof(Plane2) +
+		convex.m_convexPoly.GetVertexArray().size() * sizeof(Vec2);
+}
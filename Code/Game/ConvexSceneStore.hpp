@@ -0,0 +1,74 @@
+//----------------------------------------------------------------------------------------------------
+// ConvexSceneStore.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include "Engine/Math/ConvexHull2.hpp"
+#include "Engine/Math/Vec2.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+struct Convex2;
+struct RaySlab2D;
+struct RaycastResult2D;
+
+//----------------------------------------------------------------------------------------------------
+// ConvexSceneStore - Structure-of-arrays copy of the raycast data of every Convex2 in a scene.
+//
+// Convex2 keeps a ConvexHull2, a ConvexPoly2 and its bounding volumes in one heap object, with the
+// planes and vertices in further heap blocks, so a linear sweep over std::vector<Convex2*> misses the
+// cache on every object. Here each bounding volume field is its own array and the planes of all convexes
+// are packed back to back in m_planes; convex i owns [m_firstPlane[i], m_firstPlane[i + 1]).
+// Indices match the convex array passed to Build. Render and edit through Convex2, then UpdateConvex or Build.
+//----------------------------------------------------------------------------------------------------
+class ConvexSceneStore
+{
+public:
+	void Build(std::vector<Convex2*> const& convexArray);
+
+	// Rewrites convex index after a transform; false when its plane count changed and Build is needed
+	bool UpdateConvex(int index, Convex2 const& convex);
+
+	// Plane-clips the ray against convex index (RaycastVsPlanes2D), the same kernel Convex2 uses on its hull
+	bool RaycastConvex(int index, RaySlab2D const& ray, RaycastResult2D& out_rayCastRes) const;
+
+	// Sweeps every convex in order, optionally rejecting on the bounding disc or AABB first like
+	// Convex2::RayCastVsConvex2D. Returns the index of the closest hit (-1 on miss).
+	int RaycastClosest(Vec2 const& startPos, Vec2 const& forwardNormal, float maxDist, bool discRejection, bool boxRejection, RaycastResult2D& out_closestHit) const;
+
+	// Batched rejection: one ray against every bounding disc (or AABB), 8 convexes per instruction when
+	// built with AVX2 and 4 with SSE2. Writes the indices of the convexes the ray may hit to the front of
+	// out_survivors in ascending order and returns how many there are.
+	int GatherDiscSurvivors(Vec2 const& startPos, Vec2 const& forwardNormal, float maxDist, std::vector<int>& out_survivors) const;
+	int GatherAABBSurvivors(Vec2 const& startPos, Vec2 const& forwardNormal, float maxDist, std::vector<int>& out_survivors) const;
+
+	// Gathers survivors with the disc or AABB sweep, then plane-clips only those. Returns the index of
+	// the closest hit (-1 on miss).
+	int RaycastClosestSwept(Vec2 const& startPos, Vec2 const& forwardNormal, float maxDist, bool discRejection, std::vector<int>& scratchSurvivors, RaycastResult2D& out_closestHit) const;
+
+	int    GetNumConvexes() const { return static_cast<int>(m_discRadius.size()); }
+	size_t GetMemoryFootprintBytes() const;
+
+	// What the same convex costs as a heap Convex2 behind a pointer (object, pointer, plane and vertex blocks)
+	static size_t GetConvexFootprintBytes(Convex2 const& convex);
+
+	// Bounding discs
+	std::vector<float> m_discCenterX;
+	std::vector<float> m_discCenterY;
+	std::vector<float> m_discRadius;
+
+	// Bounding boxes
+	std::vector<float> m_aabbMinX;
+	std::vector<float> m_aabbMinY;
+	std::vector<float> m_aabbMaxX;
+	std::vector<float> m_aabbMaxY;
+
+	// Hull planes of every convex, back to back; m_firstPlane has GetNumConvexes() + 1 entries
+	std::vector<Plane2> m_planes;
+	std::vector<int>    m_firstPlane;
+
+private:
+	void WriteBoundingVolumes(int index, Convex2 const& convex);
+};
@@ -8,6 +8,13 @@
 #include "Game/App.hpp"
 #include "Game/Convex.hpp"
 #include "Game/GameCommon.hpp"
+#include "Game/MappedFile.hpp"
+#include "Game/RayBatchJob.hpp"
+#include "Game/RayBenchmark.hpp"
+#include "Game/RaySlab.hpp"
+#include "Game/SceneChunkJob.hpp"
+#include "Game/SceneHash.hpp"
+#include "Game/SceneLoadJob.hpp"
 //----------------------------------------------------------------------------------------------------
 #include "Engine/Core/BufferParser.hpp"
 #include "Engine/Core/BufferWriter.hpp"
@@ -32,7 +39,9 @@
 //----------------------------------------------------------------------------------------------------
 #include <algorithm>
 #include <cfloat>
+#include <chrono>
 #include <filesystem>
+#include <thread>
 #include <unordered_map>
 
 // Windows.h redefines ERROR after DevConsole.hpp #undef'd it
@@ -48,6 +57,36 @@ constexpr float CONVEX_WORLD_SIZE_Y = 100.f;
 constexpr float MIN_CONVEX_RADIUS   = 2.f;
 constexpr float MAX_CONVEX_RADIUS   = 8.f;
 constexpr int   INITIAL_CONVEX_COUNT = 8;
+constexpr float MAX_BVH_REFIT_COST_RATIO = 1.5f;   // Rebuild a refitted BVH once its node perimeters grow 50%
+constexpr float RAY_FAN_DEGREES          = 10.f;   // Spread of the coherent fans TestRays compares packets on
+
+// GHCS scene file version written by SaveSceneToFile; LoadSceneFromFile also reads every older 2.x minor
+constexpr uint8_t  GHCS_MAJOR_VERSION        = 2;
+constexpr uint8_t  GHCS_MINOR_VERSION        = 2;
+constexpr uint32_t GHCS_INVALID_OBJECT_INDEX = 0xFFFFFFFFu;   // Tree entry whose convex is not in m_convexes
+
+//----------------------------------------------------------------------------------------------------
+static char const* GetSceneLoadStageName_GCS(eSceneLoadStage const stage)
+{
+    switch (stage)
+    {
+    case eSceneLoadStage::QUEUED:     return "queued for the I/O thread";
+    case eSceneLoadStage::VALIDATING: return "validating header and chunks";
+    case eSceneLoadStage::DECODING:   return "decoding chunks";
+    case eSceneLoadStage::BUILDING:   return "building spatial structures";
+    default:                          return "done";
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Size for the console report only; a file moved or deleted since it was written or read reports 0 instead of throwing
+//----------------------------------------------------------------------------------------------------
+static double GetFileSizeMB_GCS(std::string const& filePath)
+{
+    std::error_code sizeError;
+    uintmax_t const fileSize = std::filesystem::file_size(filePath, sizeError);
+    return sizeError ? 0.0 : static_cast<double>(fileSize) / (1024.0 * 1024.0);
+}
 
 //----------------------------------------------------------------------------------------------------
 GameConvexScene::GameConvexScene()
@@ -92,6 +131,7 @@ GameConvexScene::GameConvexScene()
     // Register dev console commands
     g_eventSystem->SubscribeEventCallbackFunction("SaveConvexScene", SaveConvexSceneCommand);
     g_eventSystem->SubscribeEventCallbackFunction("LoadConvexScene", LoadConvexSceneCommand);
+    g_eventSystem->SubscribeEventCallbackFunction("GenerateConvexScene", GenerateConvexSceneCommand);
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -99,12 +139,24 @@ GameConvexScene::~GameConvexScene()
 {
     g_eventSystem->UnsubscribeEventCallbackFunction("SaveConvexScene", SaveConvexSceneCommand);
     g_eventSystem->UnsubscribeEventCallbackFunction("LoadConvexScene", LoadConvexSceneCommand);
+    g_eventSystem->UnsubscribeEventCallbackFunction("GenerateConvexScene", GenerateConvexSceneCommand);
 
-    for (Convex2* convex : m_convexes)
+    // The load job owns its result, so an unfinished one is waited for and discarded
+    while (m_asyncLoadJob != nullptr)
     {
-        delete convex;
+        if (g_jobSystem->RetrieveCompletedJob() == m_asyncLoadJob)
+        {
+            delete m_asyncLoadJob;
+            m_asyncLoadJob = nullptr;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
     }
+
     m_convexes.clear();
+    m_convexPool.Reset();
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -112,6 +164,9 @@ void GameConvexScene::Update()
 {
     float const deltaSeconds = static_cast<float>(m_gameClock->GetDeltaSeconds());
 
+    // Frame boundary: a finished async load replaces the scene before this frame's input touches it
+    UpdateAsyncSceneLoad();
+
     UpdateFromKeyboard(deltaSeconds);
     UpdateFromController(deltaSeconds);
 }
@@ -152,29 +207,33 @@ void GameConvexScene::UpdateFromKeyboard(float const deltaSeconds)
     // Handle object scaling
     if (m_hoveringConvex && g_input->IsKeyDown('L'))
     {
+        AABB2 oldBounds = m_hoveringConvex->m_boundingAABB;
         m_hoveringConvex->Scale(1.f * interactScale * deltaSeconds, cursorPos);
         m_sceneModified = true;
-        RebuildAllTrees();
+        RefitTreesForConvex(m_hoveringConvex, oldBounds);
     }
     if (m_hoveringConvex && g_input->IsKeyDown('K'))
     {
+        AABB2 oldBounds = m_hoveringConvex->m_boundingAABB;
         m_hoveringConvex->Scale(-1.f * interactScale * deltaSeconds, cursorPos);
         m_sceneModified = true;
-        RebuildAllTrees();
+        RefitTreesForConvex(m_hoveringConvex, oldBounds);
     }
 
     // Handle object rotation
     if (m_hoveringConvex && g_input->IsKeyDown('W'))
     {
+        AABB2 oldBounds = m_hoveringConvex->m_boundingAABB;
         m_hoveringConvex->Rotate(90.f * deltaSeconds, cursorPos);
         m_sceneModified = true;
-        RebuildAllTrees();
+        RefitTreesForConvex(m_hoveringConvex, oldBounds);
     }
     if (m_hoveringConvex && g_input->IsKeyDown('R'))
     {
+        AABB2 oldBounds = m_hoveringConvex->m_boundingAABB;
         m_hoveringConvex->Rotate(-90.f * deltaSeconds, cursorPos);
         m_sceneModified = true;
-        RebuildAllTrees();
+        RefitTreesForConvex(m_hoveringConvex, oldBounds);
     }
 
     // Handle object dragging
@@ -186,10 +245,11 @@ void GameConvexScene::UpdateFromKeyboard(float const deltaSeconds)
     if (m_isDragging && m_hoveringConvex && g_input->IsKeyDown(KEYCODE_LEFT_MOUSE))
     {
         Vec2 delta = cursorPos - m_cursorPrevPos;
+        AABB2 oldBounds = m_hoveringConvex->m_boundingAABB;
         m_hoveringConvex->Translate(delta);
         m_cursorPrevPos = cursorPos;
         m_sceneModified = true;
-        RebuildAllTrees();
+        RefitTreesForConvex(m_hoveringConvex, oldBounds);
     }
 
     if (g_input->WasKeyJustReleased(KEYCODE_LEFT_MOUSE))
@@ -253,9 +313,17 @@ void GameConvexScene::UpdateFromKeyboard(float const deltaSeconds)
     {
         m_showSpatialStructure = !m_showSpatialStructure;
     }
+    else if (g_input->WasKeyJustPressed(KEYCODE_F5))
+    {
+        m_debugDrawGridMode = !m_debugDrawGridMode;
+        if (m_debugDrawGridMode)
+        {
+            m_uniformGrid.BuildGrid(m_convexes);
+        }
+    }
     else if (g_input->WasKeyJustPressed(KEYCODE_F9))
     {
-        m_rayOptimizationMode = (m_rayOptimizationMode + 1) % 3;
+        m_rayOptimizationMode = (m_rayOptimizationMode + 1) % 5;
     }
     else if (g_input->WasKeyJustPressed('C'))
     {
@@ -264,6 +332,7 @@ void GameConvexScene::UpdateFromKeyboard(float const deltaSeconds)
         Vec2 worldPos = m_worldCamera->GetCursorWorldPosition(mouseUV);
         Convex2* convex = CreateRandomConvex(worldPos, MIN_CONVEX_RADIUS, MAX_CONVEX_RADIUS);
         m_convexes.push_back(convex);
+        RebuildAllTrees();
     }
     else if (g_input->WasKeyJustPressed('Y'))
     {
@@ -293,7 +362,7 @@ void GameConvexScene::UpdateFromKeyboard(float const deltaSeconds)
         for (int i = 0; i < numOfShapesToRemove; ++i)
         {
             if (m_convexes.back() == m_hoveringConvex) m_hoveringConvex = nullptr;
-            delete m_convexes.back();
+            m_convexPool.Destroy(m_convexes.back());
             m_convexes.pop_back();
         }
         RebuildAllTrees();
@@ -315,6 +384,10 @@ void GameConvexScene::UpdateFromKeyboard(float const deltaSeconds)
     {
         TestRays();
     }
+    else if (g_input->WasKeyJustPressed('J'))
+    {
+        m_parallelRayTest = !m_parallelRayTest;
+    }
 
     // Time controls
     if (g_input->WasKeyJustPressed(KEYCODE_P)) m_gameClock->TogglePause();
@@ -433,6 +506,38 @@ void GameConvexScene::RenderConvexScene() const
         }
     }
 
+    // Debug visualization: uniform grid cells, with the cells the DDA walks for the current ray (F5)
+    if (m_debugDrawGridMode && m_uniformGrid.GetNumCells() > 0)
+    {
+        AABB2 const& gridBox = m_uniformGrid.m_bounds;
+        for (int cellX = 0; cellX <= m_uniformGrid.m_numCellsX; ++cellX)
+        {
+            float const x = gridBox.m_mins.x + static_cast<float>(cellX) * m_uniformGrid.m_cellSizeX;
+            DebugDrawLine(Vec2(x, gridBox.m_mins.y), Vec2(x, gridBox.m_maxs.y), debugStroke, Rgba8(100, 100, 100, 160));
+        }
+        for (int cellY = 0; cellY <= m_uniformGrid.m_numCellsY; ++cellY)
+        {
+            float const y = gridBox.m_mins.y + static_cast<float>(cellY) * m_uniformGrid.m_cellSizeY;
+            DebugDrawLine(Vec2(gridBox.m_mins.x, y), Vec2(gridBox.m_maxs.x, y), debugStroke, Rgba8(100, 100, 100, 160));
+        }
+
+        float const rayLength = (m_rayEnd - m_rayStart).GetLength();
+        if (rayLength > 0.001f)
+        {
+            std::vector<int> rayCells;
+            m_uniformGrid.SolveRayCells(m_rayStart, (m_rayEnd - m_rayStart) / rayLength, rayLength, rayCells);
+            for (int cellIndex : rayCells)
+            {
+                AABB2 const box   = m_uniformGrid.GetCellBounds(cellIndex);
+                Rgba8 const color = m_uniformGrid.GetNumCellConvexes(cellIndex) > 0 ? Rgba8(255, 200, 0, 200) : Rgba8(0, 200, 255, 160);
+                DebugDrawLine(box.m_mins, Vec2(box.m_mins.x, box.m_maxs.y), debugStroke, color);
+                DebugDrawLine(Vec2(box.m_mins.x, box.m_maxs.y), box.m_maxs, debugStroke, color);
+                DebugDrawLine(Vec2(box.m_maxs.x, box.m_mins.y), box.m_maxs, debugStroke, color);
+                DebugDrawLine(Vec2(box.m_maxs.x, box.m_mins.y), box.m_mins, debugStroke, color);
+            }
+        }
+    }
+
     // Loaded scene bounds outline (white rectangle to delineate scene area)
     if (m_hasLoadedScene)
     {
@@ -468,18 +573,27 @@ void GameConvexScene::RenderConvexSceneControlText() const
     float yTop = 760.f;
 
     // Line 1: Controls
-    char const* optModeNames[] = {"None", "Disc", "AABB"};
+    char const* optModeNames[] = {"None", "Disc", "AABB", "DiscSweep", "AABBSweep"};
     std::string controlLine = Stringf("F8=Randomize, LMB/RMB=RayStart/End, W/R=Rotate, L/K=Scale, C=Spawn, ESC=Quit, F9=Opt(%s)", optModeNames[m_rayOptimizationMode]);
     AABB2 controlBox(Vec2(0.f, yTop - lineHeight), Vec2(screenSizeX, yTop));
     bitmapFont->AddVertsForTextInBox2D(verts, controlLine.c_str(), controlBox, lineHeight, Rgba8::GREEN);
     yTop -= lineHeight;
 
     // Line 2: Debug toggles + shape/ray counts
-    std::string infoLine = Stringf("F1=Discs, F2=DrawMode, F3=BVH, F4=AABB | %d shapes (Y/U), %d rays (M/N), T=Test", static_cast<int>(m_convexes.size()), m_numOfRandomRays);
+    std::string infoLine = Stringf("F1=Discs, F2=DrawMode, F3=BVH, F4=AABB, F5=Grid | %d shapes (Y/U), %d rays (M/N), T=Test, J=Parallel(%s)", static_cast<int>(m_convexes.size()), m_numOfRandomRays, m_parallelRayTest ? "On" : "Off");
     AABB2 infoBox(Vec2(0.f, yTop - lineHeight), Vec2(screenSizeX, yTop));
     bitmapFont->AddVertsForTextInBox2D(verts, infoLine.c_str(), infoBox, lineHeight, Rgba8::GREEN);
     yTop -= lineHeight;
 
+    // Async load status while the current scene stays interactive
+    if (IsAsyncSceneLoadInFlight())
+    {
+        std::string loadLine = Stringf("Loading %s: %s", m_asyncLoadJob->m_filePath.c_str(), GetSceneLoadStageName_GCS(m_asyncLoadJob->m_progress.m_stage));
+        AABB2 loadBox(Vec2(0.f, yTop - lineHeight), Vec2(screenSizeX, yTop));
+        bitmapFont->AddVertsForTextInBox2D(verts, loadLine.c_str(), loadBox, lineHeight, Rgba8::YELLOW);
+        yTop -= lineHeight;
+    }
+
     // Line 3+: Performance results (if available)
     if (m_avgDist != 0.f)
     {
@@ -488,14 +602,24 @@ void GameConvexScene::RenderConvexSceneControlText() const
         bitmapFont->AddVertsForTextInBox2D(verts, resultLine.c_str(), resultBox, lineHeight, Rgba8::YELLOW);
         yTop -= lineHeight;
 
-        std::string timingLine1 = Stringf("No Opt: %.2fms  Disc: %.2fms  AABB: %.2fms", m_lastRayTestNormalTime, m_lastRayTestDiscRejectionTime, m_lastRayTestAABBRejectionTime);
-        AABB2 timingBox1(Vec2(0.f, yTop - lineHeight), Vec2(screenSizeX, yTop));
-        bitmapFont->AddVertsForTextInBox2D(verts, timingLine1.c_str(), timingBox1, lineHeight, Rgba8::YELLOW);
-        yTop -= lineHeight;
-
-        std::string timingLine2 = Stringf("QuadTree: %.2fms  BVH: %.2fms", m_lastRayTestSymmetricTreeTime, m_lastRayTestAABBTreeTime);
-        AABB2 timingBox2(Vec2(0.f, yTop - lineHeight), Vec2(screenSizeX, yTop));
-        bitmapFont->AddVertsForTextInBox2D(verts, timingLine2.c_str(), timingBox2, lineHeight, Rgba8::YELLOW);
+        // Three strategies per line
+        constexpr int strategiesPerLine = 3;
+        for (int first = 0; first < static_cast<int>(m_lastRayTestResults.size()); first += strategiesPerLine)
+        {
+            std::string timingLine;
+            for (int index = first; index < first + strategiesPerLine && index < static_cast<int>(m_lastRayTestResults.size()); ++index)
+            {
+                RayStrategyResult const& result = m_lastRayTestResults[index];
+                timingLine += Stringf("%s: %.2fms  ", GetRayStrategyName(result.m_strategy), result.m_elapsedMs);
+                if (result.m_parallelElapsedMs > 0.0)
+                {
+                    timingLine += Stringf("(MT %.2fms x%.1f)  ", result.m_parallelElapsedMs, result.GetParallelSpeedup());
+                }
+            }
+            AABB2 timingBox(Vec2(0.f, yTop - lineHeight), Vec2(screenSizeX, yTop));
+            bitmapFont->AddVertsForTextInBox2D(verts, timingLine.c_str(), timingBox, lineHeight, Rgba8::YELLOW);
+            yTop -= lineHeight;
+        }
     }
 
     g_renderer->SetModelConstants();
@@ -538,15 +662,25 @@ void GameConvexScene::RenderRaycast(std::vector<Vertex_PCU>& verts) const
     RaycastResult2D closestResult;
     closestResult.m_didImpact = false;
 
-    for (Convex2* convex : m_convexes)
+    // Sweep modes: batched disc/AABB rejection over the SoA store, exact test on the survivors only
+    if (m_rayOptimizationMode >= 3)
+    {
+        std::vector<int> survivors;
+        m_convexStore.RaycastClosestSwept(m_rayStart, rayNormal, rayMaxLength, m_rayOptimizationMode == 3, survivors, closestResult);
+    }
+    else
     {
-        RaycastResult2D result;
-        bool discRejection = (m_rayOptimizationMode == 1);
-        bool boxRejection  = (m_rayOptimizationMode == 2);
-        bool didHit = convex->RayCastVsConvex2D(result, m_rayStart, rayNormal, rayMaxLength, discRejection, boxRejection);
-        if (didHit && (!closestResult.m_didImpact || result.m_impactLength < closestResult.m_impactLength))
+        RaySlab2D const ray(m_rayStart, rayNormal, rayMaxLength);
+        for (Convex2* convex : m_convexes)
         {
-            closestResult = result;
+            RaycastResult2D result;
+            bool discRejection = (m_rayOptimizationMode == 1);
+            bool boxRejection  = (m_rayOptimizationMode == 2);
+            bool didHit = convex->RayCastVsConvex2D(result, ray, discRejection, boxRejection);
+            if (didHit && (!closestResult.m_didImpact || result.m_impactLength < closestResult.m_impactLength))
+            {
+                closestResult = result;
+            }
         }
     }
 
@@ -609,28 +743,7 @@ void GameConvexScene::RenderRaycast(std::vector<Vertex_PCU>& verts) const
 //----------------------------------------------------------------------------------------------------
 Convex2* GameConvexScene::CreateRandomConvex(Vec2 const& center, float minRadius, float maxRadius)
 {
-    int numSides = g_rng->RollRandomIntInRange(3, 8);
-    float radius = g_rng->RollRandomFloatInRange(minRadius, maxRadius);
-
-    float angleStep = 360.f / static_cast<float>(numSides);
-    std::vector<float> angles;
-    for (int i = 0; i < numSides; ++i)
-    {
-        float baseAngle      = angleStep * static_cast<float>(i);
-        float angleVariation = g_rng->RollRandomFloatInRange(-angleStep * 0.3f, angleStep * 0.3f);
-        angles.push_back(baseAngle + angleVariation);
-    }
-    std::sort(angles.begin(), angles.end());
-
-    std::vector<Vec2> vertices;
-    for (int i = 0; i < numSides; ++i)
-    {
-        Vec2 vertex = center + Vec2::MakeFromPolarDegrees(angles[i], radius);
-        vertices.push_back(vertex);
-    }
-
-    ConvexPoly2 poly(vertices);
-    return new Convex2(poly);
+    return CreateRandomConvex2(m_convexPool, *g_rng, center, minRadius, maxRadius);
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -638,156 +751,189 @@ void GameConvexScene::TestRays()
 {
     RebuildAllTrees();
 
-    int numRays = m_numOfRandomRays;
+    RayBatch rays;
+    GenerateRandomRays(rays, m_numOfRandomRays, GetWorldBounds(), *g_rng);
+
+    RayBenchmarkScene scene;
+    scene.m_convexes         = &m_convexes;
+    scene.m_convexStore      = &m_convexStore;
+    scene.m_symQuadTree      = &m_symQuadTree;
+    scene.m_adaptiveQuadTree = &m_adaptiveQuadTree;
+    scene.m_looseQuadTree    = &m_looseQuadTree;
+    scene.m_AABB2Tree        = &m_AABB2Tree;
+    scene.m_AABB2TreeSAH     = &m_AABB2TreeSAH;
+    scene.m_AABB2Tree4SAH    = &m_AABB2Tree4SAH;
+    scene.m_uniformGrid      = &m_uniformGrid;
+
+    m_lastRayTestResults = RunAllRayStrategies(scene, rays);
+
+    RayStrategyResult const& baseline = m_lastRayTestResults[static_cast<int>(eRayStrategy::BRUTE_FORCE)];
+    m_avgDist = baseline.m_sumDist / static_cast<float>(baseline.m_numOfRayHit);
+
+    for (RayStrategyResult const& result : m_lastRayTestResults)
+    {
+        GUARANTEE_OR_DIE(result.m_matchesBaseline, Stringf("%s mismatch", GetRayStrategyName(result.m_strategy)));
+    }
+
+    // Tree footprint next to what its traversal buys over testing every convex
+    RayStrategyResult const& bvhResult = m_lastRayTestResults[static_cast<int>(eRayStrategy::AABB2_TREE)];
+    RayStrategyResult const& sahResult = m_lastRayTestResults[static_cast<int>(eRayStrategy::AABB2_TREE_SAH)];
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("BVH: %d nodes, %.1f KB, x%.2f vs NoOpt | SAH: %d nodes, %.1f KB, x%.2f vs NoOpt",
+                                                          static_cast<int>(m_AABB2Tree.m_nodes.size()), m_AABB2Tree.GetMemoryFootprintBytes() / 1024.f,
+                                                          bvhResult.GetSpeedupOver(baseline),
+                                                          static_cast<int>(m_AABB2TreeSAH.m_nodes.size()), m_AABB2TreeSAH.GetMemoryFootprintBytes() / 1024.f,
+                                                          sahResult.GetSpeedupOver(baseline)));
+    // Same traversal on the flat node layout and on a copy with a heap vector per node, as before the flattening
+    double bvhFlatMs   = 0.0;
+    double bvhVectorMs = 0.0;
+    double sahFlatMs   = 0.0;
+    double sahVectorMs = 0.0;
+    bool const bvhLayoutsMatch = MeasureAABB2TreeLayouts(m_AABB2Tree, rays, bvhFlatMs, bvhVectorMs);
+    bool const sahLayoutsMatch = MeasureAABB2TreeLayouts(m_AABB2TreeSAH, rays, sahFlatMs, sahVectorMs);
+    GUARANTEE_OR_DIE(bvhLayoutsMatch && sahLayoutsMatch, "AABB2Tree flat and per-node vector layouts disagree");
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("Flat layout vs per-node vectors: BVH %.2fms / %.2fms x%.2f | SAH %.2fms / %.2fms x%.2f",
+                                                          bvhFlatMs, bvhVectorMs, bvhVectorMs / std::max(bvhFlatMs, 1e-6),
+                                                          sahFlatMs, sahVectorMs, sahVectorMs / std::max(sahFlatMs, 1e-6)));
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("AdaptiveQT: %d nodes, %.1f KB | LooseQT: %d nodes, %.1f KB",
+                                                          static_cast<int>(m_adaptiveQuadTree.m_nodes.size()), m_adaptiveQuadTree.GetMemoryFootprintBytes() / 1024.f,
+                                                          static_cast<int>(m_looseQuadTree.m_nodes.size()), m_looseQuadTree.GetMemoryFootprintBytes() / 1024.f));
+
+    float avgQuadTreeCells        = 0.f;
+    float avgQuadTreeClosestCells = 0.f;
+    MeasureQuadTreeCellsPerRay(m_symQuadTree, rays, avgQuadTreeCells, avgQuadTreeClosestCells);
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("QuadTree: %.2f cells/ray, x%.2f vs NoOpt | QuadTree-Closest: %.2f cells/ray, x%.2f vs NoOpt",
+                                                          avgQuadTreeCells, m_lastRayTestResults[static_cast<int>(eRayStrategy::SYMMETRIC_QUAD_TREE)].GetSpeedupOver(baseline),
+                                                          avgQuadTreeClosestCells, m_lastRayTestResults[static_cast<int>(eRayStrategy::SYMMETRIC_QUAD_TREE_CLOSEST_HIT)].GetSpeedupOver(baseline)));
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("Grid: %dx%d cells, %.1f KB, x%.2f vs NoOpt, x%.2f vs SAH4-Closest",
+                                                          m_uniformGrid.m_numCellsX, m_uniformGrid.m_numCellsY, m_uniformGrid.GetMemoryFootprintBytes() / 1024.f,
+                                                          m_lastRayTestResults[static_cast<int>(eRayStrategy::UNIFORM_GRID_DDA)].GetSpeedupOver(baseline),
+                                                          m_lastRayTestResults[static_cast<int>(eRayStrategy::UNIFORM_GRID_DDA)].GetSpeedupOver(m_lastRayTestResults[static_cast<int>(eRayStrategy::AABB2_TREE4_SAH_CLOSEST_HIT)])));
+
+    // Same sweeps over the SoA store instead of Convex2 pointers
+    size_t convexBytes = 0;
+    for (Convex2 const* convex : m_convexes)
+    {
+        convexBytes += ConvexSceneStore::GetConvexFootprintBytes(*convex);
+    }
+    float const numConvexes = static_cast<float>(m_convexes.size());
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("Convex2*: %.0f B/object | SoA: %.0f B/object | NoOpt-SoA x%.2f, Disc-SoA x%.2f, AABB-SoA x%.2f",
+                                                          static_cast<float>(convexBytes) / numConvexes, static_cast<float>(m_convexStore.GetMemoryFootprintBytes()) / numConvexes,
+                                                          m_lastRayTestResults[static_cast<int>(eRayStrategy::SOA_BRUTE_FORCE)].GetSpeedupOver(baseline),
+                                                          m_lastRayTestResults[static_cast<int>(eRayStrategy::SOA_DISC_REJECTION)].GetSpeedupOver(m_lastRayTestResults[static_cast<int>(eRayStrategy::DISC_REJECTION)]),
+                                                          m_lastRayTestResults[static_cast<int>(eRayStrategy::SOA_AABB_REJECTION)].GetSpeedupOver(m_lastRayTestResults[static_cast<int>(eRayStrategy::AABB_REJECTION)])));
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("Batched rejection: Disc-Sweep x%.2f vs Disc, AABB-Sweep x%.2f vs AABB",
+                                                          m_lastRayTestResults[static_cast<int>(eRayStrategy::SOA_DISC_SWEEP)].GetSpeedupOver(m_lastRayTestResults[static_cast<int>(eRayStrategy::DISC_REJECTION)]),
+                                                          m_lastRayTestResults[static_cast<int>(eRayStrategy::SOA_AABB_SWEEP)].GetSpeedupOver(m_lastRayTestResults[static_cast<int>(eRayStrategy::AABB_REJECTION)])));
+
+    // Packets only pay off for coherent rays, so compare them on fans of the same size as well
+    RayBatch fanRays;
+    GenerateRayFans(fanRays, m_numOfRandomRays, MAX_RAY_PACKET_SIZE, RAY_FAN_DEGREES, GetWorldBounds(), *g_rng);
+    RayStrategyResult const& packetResult    = m_lastRayTestResults[static_cast<int>(eRayStrategy::AABB2_TREE_SAH_PACKET)];
+    RayStrategyResult const& sahClosest      = m_lastRayTestResults[static_cast<int>(eRayStrategy::AABB2_TREE_SAH_CLOSEST_HIT)];
+    RayStrategyResult        fanPacketResult = RunRayStrategy(eRayStrategy::AABB2_TREE_SAH_PACKET, scene, fanRays);
+    RayStrategyResult        fanClosest      = RunRayStrategy(eRayStrategy::AABB2_TREE_SAH_CLOSEST_HIT, scene, fanRays);
+    GUARANTEE_OR_DIE(fanPacketResult.m_numOfRayHit == fanClosest.m_numOfRayHit, "SAH-Packet fan mismatch");
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("SAH-Packet%d vs SAH-Closest (Mrays/s): random %.2f vs %.2f | fans %.2f vs %.2f",
+                                                          MAX_RAY_PACKET_SIZE,
+                                                          packetResult.GetRaysPerSecond(m_numOfRandomRays) / 1e6, sahClosest.GetRaysPerSecond(m_numOfRandomRays) / 1e6,
+                                                          fanPacketResult.GetRaysPerSecond(m_numOfRandomRays) / 1e6, fanClosest.GetRaysPerSecond(m_numOfRandomRays) / 1e6));
+
+    // Re-run the same batch chunked on the JobSystem and report the speedup over the serial run.
+    // Completed jobs share one queue and RunRayStrategyParallel dies on any it did not submit, so it sits out while an
+    // async load is in flight.
+    if (m_parallelRayTest && IsAsyncSceneLoadInFlight())
+    {
+        g_devConsole->AddLine(DevConsole::WARNING, "Parallel ray test skipped while a scene is loading");
+    }
+    else if (m_parallelRayTest)
+    {
+        for (RayStrategyResult& result : m_lastRayTestResults)
+        {
+            RunRayStrategyParallel(scene, rays, result);
+            GUARANTEE_OR_DIE(result.m_parallelMatchesSerial, Stringf("%s parallel mismatch", GetRayStrategyName(result.m_strategy)));
+            g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("%s: serial %.2fms, parallel %.2fms (x%.2f)",
+                                                                  GetRayStrategyName(result.m_strategy), result.m_elapsedMs,
+                                                                  result.m_parallelElapsedMs, result.GetParallelSpeedup()));
+        }
+    }
+}
 
-    std::vector<Vec2>  rayStartPos(numRays);
-    std::vector<Vec2>  rayForwardNormal(numRays);
-    std::vector<float> rayMaxDist(numRays);
+//----------------------------------------------------------------------------------------------------
+void GameConvexScene::RebuildAllTrees()
+{
+    AABB2 totalBounds = GetWorldBounds();
 
-    AABB2 worldBounds = GetWorldBounds();
-    for (int j = 0; j < numRays; ++j)
-    {
-        Vec2 p1(g_rng->RollRandomFloatInRange(worldBounds.m_mins.x, worldBounds.m_maxs.x),
-                g_rng->RollRandomFloatInRange(worldBounds.m_mins.y, worldBounds.m_maxs.y));
-        Vec2 p2(g_rng->RollRandomFloatInRange(worldBounds.m_mins.x, worldBounds.m_maxs.x),
-                g_rng->RollRandomFloatInRange(worldBounds.m_mins.y, worldBounds.m_maxs.y));
-        rayStartPos[j]      = p1;
-        Vec2 disp            = p2 - p1;
-        rayMaxDist[j]        = disp.GetLength();
-        rayForwardNormal[j]  = disp.GetNormalized();
-    }
+    int bvhDepth = GetDefaultAABB2TreeDepth(static_cast<int>(m_convexes.size()));
 
-    RaycastResult2D rayRes;
-    double startTime, endTime;
-    float sumDist;
-    int numOfRayHit, correctNumOfRayHit;
+    m_AABB2Tree.BuildTree(m_convexes, bvhDepth, totalBounds);
+    m_AABB2TreeSAH.BuildTreeSAH(m_convexes);
+    m_AABB2Tree4SAH.BuildFromBinary(m_AABB2TreeSAH);
+    m_symQuadTree.BuildTree(m_convexes, 4, totalBounds);
+    m_adaptiveQuadTree.BuildTree(m_convexes, totalBounds);
+    m_looseQuadTree.BuildTree(m_convexes, totalBounds, true);
+    m_convexStore.Build(m_convexes);
+    m_uniformGrid.BuildGrid(m_convexes);
+    RebuildHoverOrder();
+}
 
-    // Mode 1: No optimization (baseline)
-    sumDist = 0.f; numOfRayHit = 0;
-    startTime = GetCurrentTimeSeconds();
-    for (int j = 0; j < numRays; ++j)
+//----------------------------------------------------------------------------------------------------
+// Hover picks through m_AABB2TreeSAH, which returns convexes in leaf order; this restores scene order.
+// RefitTreesForConvex also uses it to find a convex's slot in m_convexStore.
+//----------------------------------------------------------------------------------------------------
+void GameConvexScene::RebuildHoverOrder()
+{
+    m_hoverOrder.clear();
+    m_hoverOrder.reserve(m_convexes.size());
+    for (int i = 0; i < static_cast<int>(m_convexes.size()); ++i)
     {
-        float minDist = FLT_MAX;
-        for (int i = 0; i < static_cast<int>(m_convexes.size()); ++i)
-        {
-            if (m_convexes[i]->RayCastVsConvex2D(rayRes, rayStartPos[j], rayForwardNormal[j], rayMaxDist[j], false, false))
-            {
-                if (rayRes.m_impactLength < minDist) minDist = rayRes.m_impactLength;
-            }
-        }
-        if (minDist != FLT_MAX) { sumDist += minDist; ++numOfRayHit; }
+        m_hoverOrder[m_convexes[i]] = i;
     }
-    endTime = GetCurrentTimeSeconds();
-    m_avgDist = sumDist / static_cast<float>(numOfRayHit);
-    correctNumOfRayHit = numOfRayHit;
-    m_lastRayTestNormalTime = static_cast<float>((endTime - startTime) * 1000.0);
+}
 
-    // Mode 2: Disc rejection
-    sumDist = 0.f; numOfRayHit = 0;
-    startTime = GetCurrentTimeSeconds();
-    for (int j = 0; j < numRays; ++j)
+//----------------------------------------------------------------------------------------------------
+// Per-frame path for a single transformed convex. Both BVHs are refitted and only rebuilt once their
+// cost ratio shows the refits have made them too loose; the quadtree just moves the convex between cells.
+// The adaptive quadtrees, the BVH4 and the SoA convex store are only read by TestRays, which rebuilds them first.
+// The uniform grid is too, apart from the F5 draw, so it is only rebuilt here while that is on.
+//----------------------------------------------------------------------------------------------------
+void GameConvexScene::RefitTreesForConvex(Convex2* convex, AABB2 const& oldBounds)
+{
+    // Not in the trees (every spawn and load rebuilds them, so this only guards against a stale tree)
+    if (!m_AABB2Tree.RefitConvex(convex) || !m_AABB2TreeSAH.RefitConvex(convex))
     {
-        float minDist = FLT_MAX;
-        for (int i = 0; i < static_cast<int>(m_convexes.size()); ++i)
-        {
-            if (m_convexes[i]->RayCastVsConvex2D(rayRes, rayStartPos[j], rayForwardNormal[j], rayMaxDist[j], true, false))
-            {
-                if (rayRes.m_impactLength < minDist) minDist = rayRes.m_impactLength;
-            }
-        }
-        if (minDist != FLT_MAX) { sumDist += minDist; ++numOfRayHit; }
+        RebuildAllTrees();
+        return;
     }
-    endTime = GetCurrentTimeSeconds();
-    GUARANTEE_OR_DIE(numOfRayHit == correctNumOfRayHit, "Disc rejection mismatch");
-    m_lastRayTestDiscRejectionTime = static_cast<float>((endTime - startTime) * 1000.0);
 
-    // Mode 3: AABB rejection
-    sumDist = 0.f; numOfRayHit = 0;
-    startTime = GetCurrentTimeSeconds();
-    for (int j = 0; j < numRays; ++j)
+    if (m_AABB2Tree.GetRefitCostRatio() > MAX_BVH_REFIT_COST_RATIO)
     {
-        float minDist = FLT_MAX;
-        for (int i = 0; i < static_cast<int>(m_convexes.size()); ++i)
-        {
-            if (m_convexes[i]->RayCastVsConvex2D(rayRes, rayStartPos[j], rayForwardNormal[j], rayMaxDist[j], true, true))
-            {
-                if (rayRes.m_impactLength < minDist) minDist = rayRes.m_impactLength;
-            }
-        }
-        if (minDist != FLT_MAX) { sumDist += minDist; ++numOfRayHit; }
+        m_AABB2Tree.BuildTree(m_convexes, GetDefaultAABB2TreeDepth(static_cast<int>(m_convexes.size())), GetWorldBounds());
     }
-    endTime = GetCurrentTimeSeconds();
-    GUARANTEE_OR_DIE(numOfRayHit == correctNumOfRayHit, "AABB rejection mismatch");
-    m_lastRayTestAABBRejectionTime = static_cast<float>((endTime - startTime) * 1000.0);
-
-    // Mode 4: QuadTree
-    sumDist = 0.f; numOfRayHit = 0;
-    startTime = GetCurrentTimeSeconds();
-    for (int j = 0; j < numRays; ++j)
+    if (m_AABB2TreeSAH.GetRefitCostRatio() > MAX_BVH_REFIT_COST_RATIO)
     {
-        float minDist = FLT_MAX;
-        std::vector<Convex2*> candidates;
-        m_symQuadTree.SolveRayResult(rayStartPos[j], rayForwardNormal[j], rayMaxDist[j], m_convexes, candidates);
-        for (int i = 0; i < static_cast<int>(candidates.size()); ++i)
-        {
-            if (candidates[i]->RayCastVsConvex2D(rayRes, rayStartPos[j], rayForwardNormal[j], rayMaxDist[j], true, true))
-            {
-                if (rayRes.m_impactLength < minDist) minDist = rayRes.m_impactLength;
-            }
-        }
-        if (minDist != FLT_MAX) { sumDist += minDist; ++numOfRayHit; }
+        m_AABB2TreeSAH.BuildTreeSAH(m_convexes);
     }
-    endTime = GetCurrentTimeSeconds();
-    GUARANTEE_OR_DIE(numOfRayHit == correctNumOfRayHit, "QuadTree mismatch");
-    m_lastRayTestSymmetricTreeTime = static_cast<float>((endTime - startTime) * 1000.0);
-
-    // Mode 5: BVH (AABB2Tree)
-    sumDist = 0.f; numOfRayHit = 0;
-    startTime = GetCurrentTimeSeconds();
-    for (int j = 0; j < numRays; ++j)
+    m_symQuadTree.UpdateConvex(convex, oldBounds);
+    if (m_debugDrawGridMode)
     {
-        float minDist = FLT_MAX;
-        std::vector<Convex2*> candidates;
-        m_AABB2Tree.SolveRayResult(rayStartPos[j], rayForwardNormal[j], rayMaxDist[j], candidates);
-        for (int i = 0; i < static_cast<int>(candidates.size()); ++i)
-        {
-            if (candidates[i]->RayCastVsConvex2D(rayRes, rayStartPos[j], rayForwardNormal[j], rayMaxDist[j], true, true))
-            {
-                if (rayRes.m_impactLength < minDist) minDist = rayRes.m_impactLength;
-            }
-        }
-        if (minDist != FLT_MAX) { sumDist += minDist; ++numOfRayHit; }
+        m_uniformGrid.BuildGrid(m_convexes);
     }
-    endTime = GetCurrentTimeSeconds();
-    GUARANTEE_OR_DIE(numOfRayHit == correctNumOfRayHit, "BVH mismatch");
-    m_lastRayTestAABBTreeTime = static_cast<float>((endTime - startTime) * 1000.0);
-}
-
-//----------------------------------------------------------------------------------------------------
-void GameConvexScene::RebuildAllTrees()
-{
-    AABB2 totalBounds = GetWorldBounds();
 
-    int numConvexes = static_cast<int>(m_convexes.size());
-    int bvhDepth = 0;
-    if (numConvexes > 0)
+    // The store is in m_convexes order, which m_hoverOrder already maps, so the drag path stays free of O(n) scans
+    auto const found = m_hoverOrder.find(convex);
+    if (found == m_hoverOrder.end() || !m_convexStore.UpdateConvex(found->second, *convex))
     {
-        bvhDepth = static_cast<int>(log2(static_cast<double>(numConvexes))) - 3;
-        if (bvhDepth < 3) bvhDepth = 3;
+        m_convexStore.Build(m_convexes);
     }
-
-    m_AABB2Tree.BuildTree(m_convexes, bvhDepth, totalBounds);
-    m_symQuadTree.BuildTree(m_convexes, 4, totalBounds);
 }
 
 //----------------------------------------------------------------------------------------------------
 void GameConvexScene::ClearScene()
 {
-    for (Convex2* convex : m_convexes)
-    {
-        delete convex;
-    }
+    // One pass over the pool blocks instead of a delete per convex
     m_convexes.clear();
+    m_convexPool.Reset();
+    m_hoverOrder.clear();
     m_hoveringConvex = nullptr;
     m_isDragging = false;
 }
@@ -800,13 +946,19 @@ void GameConvexScene::UpdateHoverDetection()
     Vec2 cursorUV  = g_window->GetNormalizedMouseUV();
     Vec2 cursorPos = m_worldCamera->GetCursorWorldPosition(cursorUV);
 
+    // The SAH BVH is refitted on every edit, so it is current here; only convexes under the cursor come back
     m_hoveringConvex = nullptr;
-    for (int i = static_cast<int>(m_convexes.size()) - 1; i >= 0; --i)
+    m_hoverCandidates.clear();
+    m_AABB2TreeSAH.SolvePointResult(cursorPos, m_hoverCandidates);
+
+    int topIndex = -1;
+    for (Convex2* convex : m_hoverCandidates)
     {
-        if (m_convexes[i]->IsPointInside(cursorPos))
+        auto found = m_hoverOrder.find(convex);
+        if (found != m_hoverOrder.end() && found->second > topIndex)
         {
-            m_hoveringConvex = m_convexes[i];
-            break;
+            topIndex         = found->second;
+            m_hoveringConvex = convex;
         }
     }
 
@@ -816,12 +968,27 @@ void GameConvexScene::UpdateHoverDetection()
 //----------------------------------------------------------------------------------------------------
 STATIC bool GameConvexScene::SaveConvexSceneCommand(EventArgs& args)
 {
-    std::string name = args.GetValue("name", "default");
-    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("> SaveConvexScene name=%s", name.c_str()));
-    GameConvexScene* scene = static_cast<GameConvexScene*>(g_game);
-    if (scene->SaveSceneToFile("Data/Scenes/" + name + ".ghcs"))
+    std::string name     = args.GetValue("name", "default");
+    std::string hashName = args.GetValue("hash", "xxhash64");
+    bool        quantize = args.GetValue("quantize", false);
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("> SaveConvexScene name=%s hash=%s quantize=%s", name.c_str(), hashName.c_str(),
+                                                          quantize ? "true" : "false"));
+
+    eGHCSHashType hashType = eGHCSHashType::XXHASH64;
+    if (hashName == "rolling") hashType = eGHCSHashType::ROLLING;
+    else if (hashName == "fnv1a") hashType = eGHCSHashType::FNV1A;
+    else if (hashName != "xxhash64")
+    {
+        g_devConsole->AddLine(DevConsole::ERROR, Stringf("Error: Unknown hash %s (use xxhash64, fnv1a or rolling)", hashName.c_str()));
+        return false;
+    }
+
+    GameConvexScene* scene    = static_cast<GameConvexScene*>(g_game);
+    std::string      filePath = "Data/Scenes/" + name + ".ghcs";
+    if (scene->SaveSceneToFile(filePath, hashType, quantize))
     {
-        g_devConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("Saved scene to Data/Scenes/%s.ghcs", name.c_str()));
+        double fileMB = GetFileSizeMB_GCS(filePath);
+        g_devConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("Saved scene to %s (%.2f MB)", filePath.c_str(), fileMB));
     }
     return true;
 }
@@ -829,18 +996,82 @@ STATIC bool GameConvexScene::SaveConvexSceneCommand(EventArgs& args)
 //----------------------------------------------------------------------------------------------------
 STATIC bool GameConvexScene::LoadConvexSceneCommand(EventArgs& args)
 {
-    std::string name = args.GetValue("name", "default");
-    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("> LoadConvexScene name=%s", name.c_str()));
+    std::string name  = args.GetValue("name", "default");
+    bool        async = args.GetValue("async", false);
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("> LoadConvexScene name=%s async=%s", name.c_str(), async ? "true" : "false"));
+    GameConvexScene* scene    = static_cast<GameConvexScene*>(g_game);
+    std::string      filePath = "Data/Scenes/" + name + ".ghcs";
+    if (scene->IsAsyncSceneLoadInFlight())
+    {
+        g_devConsole->AddLine(DevConsole::ERROR, "Error: A scene is already loading in the background");
+        return false;
+    }
+    if (async)
+    {
+        return scene->BeginAsyncSceneLoad(filePath);
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+    if (scene->LoadSceneFromFile(filePath))
+    {
+        double loadMs   = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+        double fileMB   = GetFileSizeMB_GCS(filePath);
+        double loadMBps = (loadMs > 0.0) ? fileMB * 1000.0 / loadMs : 0.0;
+        g_devConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("Loaded scene from %s", filePath.c_str()));
+        g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("%d convexes, %.2f MB in %.2fms (%.1f MB/s), %d pool block allocations (%d convexes per block)",
+                                                              scene->m_convexPool.GetNumLiveConvexes(), fileMB, loadMs, loadMBps,
+                                                              scene->m_convexPool.GetNumBlockAllocations(), CONVEX_POOL_BLOCK_SIZE));
+
+        // Load-with-tree vs load-then-rebuild: time fresh builds of both BVHs over the loaded convexes
+        if (args.GetValue("compareRebuild", false))
+        {
+            AABB2Tree midpointTree;
+            AABB2Tree sahTree;
+            auto      rebuildStartTime = std::chrono::steady_clock::now();
+            midpointTree.BuildTree(scene->m_convexes, GetDefaultAABB2TreeDepth(static_cast<int>(scene->m_convexes.size())), scene->GetWorldBounds());
+            sahTree.BuildTreeSAH(scene->m_convexes);
+            double rebuildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - rebuildStartTime).count();
+            g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("Rebuilding both BVHs takes %.2fms vs %.2fms restoring them from the file (%.1fx)",
+                                                                  rebuildMs, scene->m_lastBVHRestoreMs,
+                                                                  scene->m_lastBVHRestoreMs > 0.0 ? rebuildMs / scene->m_lastBVHRestoreMs : 0.0));
+        }
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Stress scenes past the 2048 cap of the Y key, e.g. for save/load round trips of large files
+//----------------------------------------------------------------------------------------------------
+STATIC bool GameConvexScene::GenerateConvexSceneCommand(EventArgs& args)
+{
+    int count = args.GetValue("count", 100000);
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("> GenerateConvexScene count=%d", count));
+    if (count <= 0)
+    {
+        g_devConsole->AddLine(DevConsole::ERROR, "Error: count must be positive");
+        return false;
+    }
+
     GameConvexScene* scene = static_cast<GameConvexScene*>(g_game);
-    if (scene->LoadSceneFromFile("Data/Scenes/" + name + ".ghcs"))
+    scene->ClearScene();
+    scene->m_sceneModified = true;
+    scene->m_convexes.reserve(count);
+    AABB2 bounds = scene->GetWorldBounds();
+    for (int i = 0; i < count; ++i)
     {
-        g_devConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("Loaded scene from Data/Scenes/%s.ghcs", name.c_str()));
+        Vec2 randomPos = Vec2(
+            g_rng->RollRandomFloatInRange(bounds.m_mins.x, bounds.m_maxs.x),
+            g_rng->RollRandomFloatInRange(bounds.m_mins.y, bounds.m_maxs.y)
+        );
+        scene->m_convexes.push_back(scene->CreateRandomConvex(randomPos, MIN_CONVEX_RADIUS, MAX_CONVEX_RADIUS));
     }
+    scene->RebuildAllTrees();
+    g_devConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("Generated %d convexes", count));
     return true;
 }
 
 //----------------------------------------------------------------------------------------------------
-bool GameConvexScene::SaveSceneToFile(std::string const& filePath)
+bool GameConvexScene::SaveSceneToFile(std::string const& filePath, eGHCSHashType const hashType, bool const quantizeGeometry)
 {
     constexpr unsigned int CHUNK_HEADER_SIZE = 10;
     constexpr unsigned int CHUNK_FOOTER_SIZE = 4;
@@ -866,11 +1097,11 @@ bool GameConvexScene::SaveSceneToFile(std::string const& filePath)
     bufWrite.AppendChar('C');
     bufWrite.AppendChar('S');
     bufWrite.AppendByte(34);  // cohort
-    bufWrite.AppendByte(2);   // major version
-    bufWrite.AppendByte(1);   // minor version
+    bufWrite.AppendByte(GHCS_MAJOR_VERSION); // major version
+    bufWrite.AppendByte(GHCS_MINOR_VERSION); // minor version (2: uint32 object counts, indices and ToC count)
     bufWrite.AppendByte(1);   // endianness: 1=LE
     bufWrite.AppendUint32(0); // placeholder for total file size
-    bufWrite.AppendByte(1);   // hash type: 1=simple rolling hash
+    bufWrite.AppendByte(static_cast<uint8_t>(hashType)); // hash type, see eGHCSHashType
     bufWrite.AppendByte(0);
     bufWrite.AppendByte(0);
     bufWrite.AppendByte(0);
@@ -916,14 +1147,66 @@ bool GameConvexScene::SaveSceneToFile(std::string const& filePath)
         size_t idx = BeginChunk(0x01);
         AABB2 cameraBounds(m_worldCamera->GetOrthographicBottomLeft(), m_worldCamera->GetOrthographicTopRight());
         bufWrite.AppendAABB2(cameraBounds);
-        bufWrite.AppendUshort(static_cast<unsigned short>(m_convexes.size()));
+        bufWrite.AppendUint32(static_cast<unsigned int>(m_convexes.size()));
+        EndChunk(idx);
+    }
+
+    // LEB128: 7 bits per byte, high bit set on every byte but the last
+    auto AppendVarUint32 = [&](uint32_t value)
+    {
+        while (value >= 0x80)
+        {
+            bufWrite.AppendByte(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        bufWrite.AppendByte(static_cast<uint8_t>(value));
+    };
+
+    // --- Chunk 0x03: QuantizedConvexPolys ---
+    // Vertices as 16-bit steps across the bounds of all vertices. Hulls, bounding volumes and trees are
+    // derived data and are left out; the loader rebuilds them.
+    if (quantizeGeometry)
+    {
+        AABB2 vertexBounds(Vec2(FLT_MAX, FLT_MAX), Vec2(-FLT_MAX, -FLT_MAX));
+        for (Convex2 const* convex : m_convexes)
+        {
+            for (Vec2 const& v : convex->m_convexPoly.GetVertexArray())
+            {
+                vertexBounds.m_mins.x = std::min(vertexBounds.m_mins.x, v.x);
+                vertexBounds.m_mins.y = std::min(vertexBounds.m_mins.y, v.y);
+                vertexBounds.m_maxs.x = std::max(vertexBounds.m_maxs.x, v.x);
+                vertexBounds.m_maxs.y = std::max(vertexBounds.m_maxs.y, v.y);
+            }
+        }
+        if (vertexBounds.m_mins.x > vertexBounds.m_maxs.x) vertexBounds = AABB2(Vec2::ZERO, Vec2::ZERO);   // No vertices
+
+        Vec2 extent = vertexBounds.m_maxs - vertexBounds.m_mins;
+        Vec2 scale  = Vec2(extent.x > 0.f ? GHCS_QUANTIZED_MAX_STEP / extent.x : 0.f,
+                           extent.y > 0.f ? GHCS_QUANTIZED_MAX_STEP / extent.y : 0.f);
+
+        size_t idx = BeginChunk(0x03);
+        bufWrite.AppendAABB2(vertexBounds);
+        bufWrite.AppendUint32(static_cast<unsigned int>(m_convexes.size()));
+        for (Convex2 const* convex : m_convexes)
+        {
+            std::vector<Vec2> const& verts = convex->m_convexPoly.GetVertexArray();
+            AppendVarUint32(static_cast<uint32_t>(verts.size()));
+            for (Vec2 const& v : verts)
+            {
+                float qx = GetClamped((v.x - vertexBounds.m_mins.x) * scale.x + 0.5f, 0.f, GHCS_QUANTIZED_MAX_STEP);
+                float qy = GetClamped((v.y - vertexBounds.m_mins.y) * scale.y + 0.5f, 0.f, GHCS_QUANTIZED_MAX_STEP);
+                bufWrite.AppendUshort(static_cast<unsigned short>(qx));
+                bufWrite.AppendUshort(static_cast<unsigned short>(qy));
+            }
+        }
         EndChunk(idx);
     }
 
     // --- Chunk 0x02: ConvexPolys ---
+    if (!quantizeGeometry)
     {
         size_t idx = BeginChunk(0x02);
-        bufWrite.AppendUshort(static_cast<unsigned short>(m_convexes.size()));
+        bufWrite.AppendUint32(static_cast<unsigned int>(m_convexes.size()));
         for (Convex2 const* convex : m_convexes)
         {
             std::vector<Vec2> const& verts = convex->m_convexPoly.GetVertexArray();
@@ -937,9 +1220,10 @@ bool GameConvexScene::SaveSceneToFile(std::string const& filePath)
     }
 
     // --- Chunk 0x81: BoundingDiscs ---
+    if (!quantizeGeometry)
     {
         size_t idx = BeginChunk(0x81);
-        bufWrite.AppendUshort(static_cast<unsigned short>(m_convexes.size()));
+        bufWrite.AppendUint32(static_cast<unsigned int>(m_convexes.size()));
         for (Convex2 const* convex : m_convexes)
         {
             bufWrite.AppendVec2(convex->m_boundingDiscCenter);
@@ -949,9 +1233,10 @@ bool GameConvexScene::SaveSceneToFile(std::string const& filePath)
     }
 
     // --- Chunk 0x80: ConvexHulls ---
+    if (!quantizeGeometry)
     {
         size_t idx = BeginChunk(0x80);
-        bufWrite.AppendUshort(static_cast<unsigned short>(m_convexes.size()));
+        bufWrite.AppendUint32(static_cast<unsigned int>(m_convexes.size()));
         for (Convex2 const* convex : m_convexes)
         {
             std::vector<Plane2> const& planes = convex->m_convexHull.m_boundingPlanes;
@@ -965,9 +1250,10 @@ bool GameConvexScene::SaveSceneToFile(std::string const& filePath)
     }
 
     // --- Chunk 0x82: BoundingAABBs ---
+    if (!quantizeGeometry)
     {
         size_t idx = BeginChunk(0x82);
-        bufWrite.AppendUshort(static_cast<unsigned short>(m_convexes.size()));
+        bufWrite.AppendUint32(static_cast<unsigned int>(m_convexes.size()));
         for (Convex2 const* convex : m_convexes)
         {
             bufWrite.AppendAABB2(convex->m_boundingAABB);
@@ -976,46 +1262,54 @@ bool GameConvexScene::SaveSceneToFile(std::string const& filePath)
     }
 
     // --- Build pointer-to-index map for tree serialization ---
-    std::unordered_map<Convex2*, uint16_t> convexIndexMap;
-    for (uint16_t i = 0; i < static_cast<uint16_t>(m_convexes.size()); ++i)
+    std::unordered_map<Convex2*, uint32_t> convexIndexMap;
+    convexIndexMap.reserve(m_convexes.size());
+    for (uint32_t i = 0; i < static_cast<uint32_t>(m_convexes.size()); ++i)
     {
         convexIndexMap[m_convexes[i]] = i;
     }
 
-    // --- Chunk 0x83: AABB2 Tree (BVH) ---
-    if (!m_AABB2Tree.m_nodes.empty())
+    // --- Chunk 0x83: AABB2 Tree (BVH), once for the midpoint and once for the SAH build ---
+    // Interior ranges are derived from the leaves on load, so only leaves list their convexes
+    for (AABB2Tree const* tree : { &m_AABB2Tree, &m_AABB2TreeSAH })
     {
+        if (quantizeGeometry || tree->m_nodes.empty()) continue;
+
         size_t idx = BeginChunk(0x83);
-        bufWrite.AppendByte(static_cast<uint8_t>(m_AABB2Tree.m_nodes.size() > 0 ? 1 : 0));
-        unsigned int numNodes = static_cast<unsigned int>(m_AABB2Tree.m_nodes.size());
+        bufWrite.AppendByte(GHCS_BVH_LAYOUT_STORED);
+        bufWrite.AppendByte(static_cast<uint8_t>(tree->GetBuildMethod()));
+        bufWrite.AppendInt32(tree->GetStartOfLastLevel());
+        unsigned int numNodes = static_cast<unsigned int>(tree->m_nodes.size());
         bufWrite.AppendUint32(numNodes);
         for (unsigned int n = 0; n < numNodes; ++n)
         {
-            AABB2TreeNode const& node = m_AABB2Tree.m_nodes[n];
+            AABB2TreeNode const& node = tree->m_nodes[n];
+            bool const isLeaf = (node.m_leftChild < 0);
             bufWrite.AppendAABB2(node.m_bounds);
-            int leftChild  = static_cast<int>(n) * 2 + 1;
-            int rightChild = static_cast<int>(n) * 2 + 2;
-            bufWrite.AppendInt32(leftChild < static_cast<int>(numNodes) ? leftChild : -1);
-            bufWrite.AppendInt32(rightChild < static_cast<int>(numNodes) ? rightChild : -1);
-            bufWrite.AppendUint32(static_cast<unsigned int>(node.m_containingConvex.size()));
-            for (Convex2* convex : node.m_containingConvex)
+            bufWrite.AppendInt32(node.m_leftChild);
+            bufWrite.AppendInt32(node.m_rightChild);
+            bufWrite.AppendUint32(isLeaf ? static_cast<unsigned int>(node.m_numPrims) : 0u);
+            if (!isLeaf) continue;
+
+            Convex2* const* nodePrims = tree->GetNodePrimitives(node);
+            for (int c = 0; c < node.m_numPrims; ++c)
             {
-                auto it = convexIndexMap.find(convex);
-                bufWrite.AppendUshort(it != convexIndexMap.end() ? it->second : static_cast<unsigned short>(0xFFFF));
+                auto it = convexIndexMap.find(nodePrims[c]);
+                bufWrite.AppendUint32(it != convexIndexMap.end() ? it->second : GHCS_INVALID_OBJECT_INDEX);
             }
         }
         EndChunk(idx);
     }
 
     // --- Chunk 0x87: Symmetric Quadtree (QuadKey format) ---
-    if (!m_symQuadTree.m_nodes.empty())
+    if (!quantizeGeometry && !m_symQuadTree.m_nodes.empty())
     {
         struct QuadKeyEntry
         {
             uint8_t  depth;
             uint16_t x;
             uint16_t y;
-            std::vector<uint16_t> objectIndices;
+            std::vector<uint32_t> objectIndices;
         };
         std::vector<QuadKeyEntry> entries;
 
@@ -1040,7 +1334,7 @@ bool GameConvexScene::SaveSceneToFile(std::string const& filePath)
                     for (Convex2* convex : node.m_containingConvex)
                     {
                         auto it = convexIndexMap.find(convex);
-                        entry.objectIndices.push_back(it != convexIndexMap.end() ? it->second : static_cast<uint16_t>(0xFFFF));
+                        entry.objectIndices.push_back(it != convexIndexMap.end() ? it->second : GHCS_INVALID_OBJECT_INDEX);
                     }
                     entries.push_back(entry);
                 }
@@ -1057,17 +1351,17 @@ bool GameConvexScene::SaveSceneToFile(std::string const& filePath)
             bufWrite.AppendByte(entry.depth);
             bufWrite.AppendUshort(entry.x);
             bufWrite.AppendUshort(entry.y);
-            bufWrite.AppendUshort(static_cast<unsigned short>(entry.objectIndices.size()));
-            for (uint16_t objIdx : entry.objectIndices)
+            bufWrite.AppendUint32(static_cast<unsigned int>(entry.objectIndices.size()));
+            for (uint32_t objIdx : entry.objectIndices)
             {
-                bufWrite.AppendUshort(objIdx);
+                bufWrite.AppendUint32(objIdx);
             }
         }
         EndChunk(idx);
     }
 
     // --- Write preserved unrecognized chunks ---
-    if (!m_sceneModified)
+    if (!m_sceneModified && !m_wasSceneModifiedBeforeAsyncLoad)
     {
         for (UnrecognizedChunk const& preserved : m_preservedChunks)
         {
@@ -1093,7 +1387,7 @@ bool GameConvexScene::SaveSceneToFile(std::string const& filePath)
     bufWrite.AppendChar('H');
     bufWrite.AppendChar('T');
     bufWrite.AppendChar('C');
-    bufWrite.AppendByte(static_cast<uint8_t>(chunkInfos.size()));
+    bufWrite.AppendUint32(static_cast<unsigned int>(chunkInfos.size()));
     for (ChunkInfo const& info : chunkInfos)
     {
         unsigned int chunkTotalSize = static_cast<unsigned int>(info.dataEnd - info.dataStart) + CHUNK_OVERHEAD;
@@ -1112,12 +1406,7 @@ bool GameConvexScene::SaveSceneToFile(std::string const& filePath)
     // --- Backpatch data hash ---
     {
         constexpr size_t HEADER_SIZE = 28;
-        unsigned int hash = 0;
-        for (size_t i = HEADER_SIZE; i < buffer.size(); ++i)
-        {
-            hash *= 31;
-            hash += buffer[i];
-        }
+        unsigned int hash = ComputeGHCSHash(hashType, buffer.data() + HEADER_SIZE, buffer.size() - HEADER_SIZE);
         bufWrite.OverwriteUint32(16, hash);
     }
 
@@ -1132,31 +1421,76 @@ bool GameConvexScene::SaveSceneToFile(std::string const& filePath)
 }
 
 //----------------------------------------------------------------------------------------------------
-bool GameConvexScene::LoadSceneFromFile(std::string const& filePath)
+// Layout of a 0x83 tree written before the build method and last level were stored: a complete tree in
+// heap order is a midpoint build, anything else came from the SAH builder
+//----------------------------------------------------------------------------------------------------
+static void InferAABB2TreeLayout_GCS(AABB2Tree& tree)
+{
+    int numNodes = static_cast<int>(tree.m_nodes.size());
+    int lastLevelStart = 0;
+    int levelSize = 1;
+    while (lastLevelStart + levelSize < numNodes)
+    {
+        lastLevelStart += levelSize;
+        levelSize *= 2;
+    }
+    tree.SetStartOfLastLevel(lastLevelStart);
+
+    bool isHeapOrder = true;
+    for (int n = 0; n < numNodes && isHeapOrder; ++n)
+    {
+        int leftChild = tree.m_nodes[n].m_leftChild;
+        isHeapOrder = (leftChild < 0 || leftChild == n * 2 + 1);
+    }
+    tree.SetBuildMethod(isHeapOrder ? eAABB2TreeBuildMethod::MIDPOINT : eAABB2TreeBuildMethod::SAH);
+}
+
+//----------------------------------------------------------------------------------------------------
+static void PrintSceneLoadMessages_GCS(LoadedConvexScene const& loadedScene)
 {
-    if (!std::filesystem::exists(filePath))
+    for (SceneLoadMessage const& message : loadedScene.m_messages)
     {
-        g_devConsole->AddLine(DevConsole::ERROR, Stringf("Error: File not found: %s", filePath.c_str()));
+        g_devConsole->AddLine(message.m_color, message.m_text);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC bool GameConvexScene::ParseSceneFile(std::string const& filePath, AABB2 const& fallbackBounds, bool const decodeOnJobSystem,
+                                            LoadedConvexScene& out_loadedScene, SceneLoadProgress* out_progress)
+{
+    auto addLine = [&out_loadedScene](Rgba8 const& color, std::string const& text) { out_loadedScene.m_messages.push_back({ color, text }); };
+    auto setStage = [out_progress](eSceneLoadStage const stage) { if (out_progress != nullptr) out_progress->m_stage = stage; };
+    setStage(eSceneLoadStage::VALIDATING);
+
+    // error_code overloads: this may run on the I/O thread, where a filesystem_error would end the process
+    std::error_code fileError;
+    if (!std::filesystem::exists(filePath, fileError))
+    {
+        addLine(DevConsole::ERROR, Stringf("Error: File not found: %s", filePath.c_str()));
         return false;
     }
-    if (std::filesystem::file_size(filePath) == 0)
+    if (std::filesystem::file_size(filePath, fileError) == 0 || fileError)
     {
-        g_devConsole->AddLine(DevConsole::ERROR, Stringf("Error: File is empty: %s", filePath.c_str()));
+        addLine(DevConsole::ERROR, Stringf("Error: File is empty or unreadable: %s", filePath.c_str()));
         return false;
     }
 
-    std::vector<uint8_t> buffer;
-    if (!FileReadToBuffer(buffer, filePath))
+    // Parse straight from the mapped pages instead of copying the file into a buffer first
+    MappedFile mappedFile;
+    if (!mappedFile.Open(filePath))
     {
-        g_devConsole->AddLine(DevConsole::ERROR, Stringf("Error: Could not read file %s", filePath.c_str()));
+        addLine(DevConsole::ERROR, Stringf("Error: Could not map file %s", filePath.c_str()));
         return false;
     }
+    unsigned char const* fileData = mappedFile.GetData();
+    size_t const         fileSize = mappedFile.GetSize();
+    out_loadedScene.m_fileSize    = fileSize;
 
-    BufferParser bufParse(buffer);
+    BufferParser bufParse(fileData, fileSize);
 
-    if (buffer.size() < 37)
+    if (fileSize < 37)
     {
-        g_devConsole->AddLine(DevConsole::ERROR, Stringf("Error: File too small (%zu bytes)", buffer.size()));
+        addLine(DevConsole::ERROR, Stringf("Error: File too small (%zu bytes)", fileSize));
         return false;
     }
 
@@ -1167,7 +1501,7 @@ bool GameConvexScene::LoadSceneFromFile(std::string const& filePath)
     char magic3 = bufParse.ParseChar();
     if (magic0 != 'G' || magic1 != 'H' || magic2 != 'C' || magic3 != 'S')
     {
-        g_devConsole->AddLine(DevConsole::ERROR, "Error: Invalid GHCS file header");
+        addLine(DevConsole::ERROR, "Error: Invalid GHCS file header");
         return false;
     }
 
@@ -1175,7 +1509,16 @@ bool GameConvexScene::LoadSceneFromFile(std::string const& filePath)
     uint8_t majorVersion = bufParse.ParseByte();
     uint8_t minorVersion = bufParse.ParseByte();
     uint8_t endianByte   = bufParse.ParseByte();
-    UNUSED(cohort); UNUSED(majorVersion); UNUSED(minorVersion);
+    UNUSED(cohort);
+
+    // Up to 2.1 object counts, object indices and the ToC chunk count are 16 / 8 bit; 2.2 widened them all to 32
+    if (majorVersion != GHCS_MAJOR_VERSION || minorVersion > GHCS_MINOR_VERSION)
+    {
+        addLine(DevConsole::ERROR, Stringf("Error: Unsupported GHCS version %d.%d (this build reads up to %d.%d)",
+                                           majorVersion, minorVersion, GHCS_MAJOR_VERSION, GHCS_MINOR_VERSION));
+        return false;
+    }
+    bool const wideIndices = (minorVersion >= 2);
 
     if (endianByte == 1)
         bufParse.SetEndianMode(eEndianMode::LITTLE);
@@ -1183,7 +1526,7 @@ bool GameConvexScene::LoadSceneFromFile(std::string const& filePath)
         bufParse.SetEndianMode(eEndianMode::BIG);
     else
     {
-        g_devConsole->AddLine(DevConsole::ERROR, Stringf("Error: Invalid endianness byte %d", endianByte));
+        addLine(DevConsole::ERROR, Stringf("Error: Invalid endianness byte %d", endianByte));
         return false;
     }
 
@@ -1193,49 +1536,36 @@ bool GameConvexScene::LoadSceneFromFile(std::string const& filePath)
     unsigned int storedHash = bufParse.ParseUint32();
     unsigned int tocOffset  = bufParse.ParseUint32();
 
-    if (totalFileSize != static_cast<unsigned int>(buffer.size()))
+    if (totalFileSize != static_cast<unsigned int>(fileSize))
     {
-        g_devConsole->AddLine(DevConsole::WARNING, Stringf("Warning: totalFileSize mismatch"));
+        addLine(DevConsole::WARNING, Stringf("Warning: totalFileSize mismatch"));
     }
 
-    // Validate hash
+    // Validate hash (types this build does not know are skipped, as before)
+    if (IsKnownGHCSHashType(hashType))
     {
         constexpr size_t HEADER_SIZE = 28;
-        if (hashType == 1)
-        {
-            unsigned int computedHash = 0;
-            for (size_t i = HEADER_SIZE; i < buffer.size(); ++i)
-            {
-                computedHash *= 31;
-                computedHash += buffer[i];
-            }
-            if (storedHash != computedHash)
-                g_devConsole->AddLine(DevConsole::WARNING, "Warning: data hash mismatch");
-        }
-        else if (hashType == 2)
-        {
-            unsigned int computedHash = 2166136261u;
-            for (size_t i = HEADER_SIZE; i < buffer.size(); ++i)
-            {
-                computedHash ^= buffer[i];
-                computedHash *= 16777619u;
-            }
-            if (storedHash != computedHash)
-                g_devConsole->AddLine(DevConsole::WARNING, "Warning: FNV-1a hash mismatch");
-        }
+        eGHCSHashType const type = static_cast<eGHCSHashType>(hashType);
+        auto hashStartTime = std::chrono::steady_clock::now();
+        unsigned int computedHash = ComputeGHCSHash(type, fileData + HEADER_SIZE, fileSize - HEADER_SIZE);
+        double hashMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - hashStartTime).count();
+        if (storedHash != computedHash)
+            addLine(DevConsole::WARNING, Stringf("Warning: %s data hash mismatch", GetGHCSHashTypeName(type)));
+        addLine(DevConsole::INFO_MINOR, Stringf("  %s hash of %zu bytes checked in %.3fms", GetGHCSHashTypeName(type),
+                                                fileSize - HEADER_SIZE, hashMs));
     }
 
     if (bufParse.ParseChar() != 'E' || bufParse.ParseChar() != 'N' ||
         bufParse.ParseChar() != 'D' || bufParse.ParseChar() != 'H')
     {
-        g_devConsole->AddLine(DevConsole::ERROR, "Error: Missing ENDH footer");
+        addLine(DevConsole::ERROR, "Error: Missing ENDH footer");
         return false;
     }
 
     // --- Jump to Table of Contents ---
-    if (static_cast<size_t>(tocOffset) + 9 > buffer.size())
+    if (static_cast<size_t>(tocOffset) + (wideIndices ? 12 : 9) > fileSize)
     {
-        g_devConsole->AddLine(DevConsole::ERROR, "Error: ToC offset exceeds buffer");
+        addLine(DevConsole::ERROR, "Error: ToC offset exceeds buffer");
         return false;
     }
     bufParse.SetCurrentPosition(static_cast<size_t>(tocOffset));
@@ -1243,14 +1573,20 @@ bool GameConvexScene::LoadSceneFromFile(std::string const& filePath)
     if (bufParse.ParseChar() != 'G' || bufParse.ParseChar() != 'H' ||
         bufParse.ParseChar() != 'T' || bufParse.ParseChar() != 'C')
     {
-        g_devConsole->AddLine(DevConsole::ERROR, "Error: Invalid ToC magic");
+        addLine(DevConsole::ERROR, "Error: Invalid ToC magic");
         return false;
     }
 
     struct ToCEntry { uint8_t type; unsigned int startPos; unsigned int totalSize; };
-    uint8_t numChunks = bufParse.ParseByte();
+    unsigned int numChunks = wideIndices ? bufParse.ParseUint32() : static_cast<unsigned int>(bufParse.ParseByte());
+    if (static_cast<size_t>(numChunks) * 9 > fileSize - bufParse.GetCurrentPosition())
+    {
+        addLine(DevConsole::ERROR, "Error: ToC chunk count exceeds buffer");
+        return false;
+    }
     std::vector<ToCEntry> tocEntries;
-    for (int i = 0; i < static_cast<int>(numChunks); ++i)
+    tocEntries.reserve(numChunks);
+    for (unsigned int i = 0; i < numChunks; ++i)
     {
         ToCEntry entry;
         entry.type      = bufParse.ParseByte();
@@ -1262,31 +1598,34 @@ bool GameConvexScene::LoadSceneFromFile(std::string const& filePath)
     if (bufParse.ParseChar() != 'E' || bufParse.ParseChar() != 'N' ||
         bufParse.ParseChar() != 'D' || bufParse.ParseChar() != 'T')
     {
-        g_devConsole->AddLine(DevConsole::ERROR, "Error: Missing ENDT footer");
+        addLine(DevConsole::ERROR, "Error: Missing ENDT footer");
         return false;
     }
 
-    // --- Process each chunk ---
+    // --- Validate each chunk and queue its decode ---
+    // Chunks are framed and validated here, in file order; their payloads are decoded below.
+    // Convexes go into their own pool until the file has validated; an early return frees it in one go
+    ConvexPool            tempPool;
     std::vector<Convex2*> tempConvexes;
     std::vector<UnrecognizedChunk> tempPreservedChunks;
     AABB2    sceneBounds;
-    uint16_t recordedNumObjects = static_cast<uint16_t>(-1);
+    uint32_t recordedNumObjects = static_cast<uint32_t>(-1);
     bool     hasSceneInfo     = false;
     bool     hasConvexPolys   = false;
     bool     hasConvexHulls   = false;
     bool     hasBoundingDiscs = false;
     bool     hasBoundingAABBs = false;
-    bool     hasAABB2Tree     = false;
     bool     hasSymQuadTree   = false;
-    AABB2Tree         tempAABB2Tree;
-    SymmetricQuadTree tempSymQuadTree;
+
+    struct PendingChunk { uint8_t type; uint8_t endian; size_t dataStartPos; unsigned int dataSize; int firstConvexIndex; };
+    std::vector<PendingChunk> pendingChunks;
+    int numConvexesToCreate = 0;
 
     for (ToCEntry const& entry : tocEntries)
     {
-        if (static_cast<size_t>(entry.startPos) + 14 > buffer.size())
+        if (static_cast<size_t>(entry.startPos) + 14 > fileSize)
         {
-            g_devConsole->AddLine(DevConsole::ERROR, "Error: Chunk startPos exceeds buffer");
-            for (Convex2* c : tempConvexes) delete c;
+            addLine(DevConsole::ERROR, "Error: Chunk startPos exceeds buffer");
             return false;
         }
         bufParse.SetCurrentPosition(static_cast<size_t>(entry.startPos));
@@ -1295,8 +1634,7 @@ bool GameConvexScene::LoadSceneFromFile(std::string const& filePath)
         if (bufParse.ParseChar() != 'G' || bufParse.ParseChar() != 'H' ||
             bufParse.ParseChar() != 'C' || bufParse.ParseChar() != 'K')
         {
-            g_devConsole->AddLine(DevConsole::ERROR, "Error: Invalid chunk header");
-            for (Convex2* c : tempConvexes) delete c;
+            addLine(DevConsole::ERROR, "Error: Invalid chunk header");
             return false;
         }
 
@@ -1308,190 +1646,179 @@ bool GameConvexScene::LoadSceneFromFile(std::string const& filePath)
         unsigned int dataSize    = bufParse.ParseUint32();
         size_t       dataStartPos = bufParse.GetCurrentPosition();
 
-        if (dataStartPos + static_cast<size_t>(dataSize) + 4 > buffer.size())
+        if (dataStartPos + static_cast<size_t>(dataSize) + 4 > fileSize)
         {
-            g_devConsole->AddLine(DevConsole::ERROR, "Error: Chunk data exceeds buffer");
-            for (Convex2* c : tempConvexes) delete c;
+            addLine(DevConsole::ERROR, "Error: Chunk data exceeds buffer");
             return false;
         }
 
-        if (chunkType == 0x01) // SceneInfo
+        if (chunkType == 0x01) // SceneInfo - tiny, and the quadtree decode needs its bounds
         {
             hasSceneInfo = true;
             sceneBounds = bufParse.ParseAABB2();
-            recordedNumObjects = bufParse.ParseUshort();
+            recordedNumObjects = wideIndices ? bufParse.ParseUint32() : static_cast<uint32_t>(bufParse.ParseUshort());
         }
-        else if (chunkType == 0x02) // ConvexPolys
+        else if (chunkType == 0x02 || chunkType == 0x03 || chunkType == 0x80 || chunkType == 0x81 || chunkType == 0x82 ||
+                 chunkType == 0x83 || chunkType == 0x87)
         {
-            hasConvexPolys = true;
-            uint16_t numObjects = bufParse.ParseUshort();
-            for (int i = 0; i < static_cast<int>(numObjects); ++i)
+            PendingChunk pending = { chunkType, chunkEndian, dataStartPos, dataSize, 0 };
+            if (chunkType == 0x02 || chunkType == 0x03) // (Quantized)ConvexPolys: only the object count is read here, so the convexes exist before any job runs
             {
-                uint8_t numVerts = bufParse.ParseByte();
-                std::vector<Vec2> verts;
-                for (int j = 0; j < static_cast<int>(numVerts); ++j)
+                hasConvexPolys = true;
+                if (chunkType == 0x03) bufParse.ParseAABB2();   // Quantization bounds precede the count
+                uint32_t numObjects = (wideIndices || chunkType == 0x03) ? bufParse.ParseUint32() : static_cast<uint32_t>(bufParse.ParseUshort());
+                if (numObjects > dataSize) // Every convex takes at least its vertex count byte
                 {
-                    verts.push_back(bufParse.ParseVec2());
+                    addLine(DevConsole::ERROR, "Error: ConvexPolys object count exceeds chunk size");
+                    return false;
                 }
-                Convex2* newConvex = new Convex2();
-                newConvex->m_convexPoly = ConvexPoly2(verts);
-                tempConvexes.push_back(newConvex);
+                pending.firstConvexIndex = numConvexesToCreate;
+                numConvexesToCreate += static_cast<int>(numObjects);
             }
+            else if (chunkType == 0x80) hasConvexHulls   = true;
+            else if (chunkType == 0x81) hasBoundingDiscs = true;
+            else if (chunkType == 0x82) hasBoundingAABBs = true;
+            else if (chunkType == 0x87) hasSymQuadTree   = true;
+            pendingChunks.push_back(pending);
         }
-        else if (chunkType == 0x80) // ConvexHulls
+        else
         {
-            hasConvexHulls = true;
-            uint16_t numObjects = bufParse.ParseUshort();
-            for (int i = 0; i < static_cast<int>(numObjects) && i < static_cast<int>(tempConvexes.size()); ++i)
+            // Preserve unrecognized chunks for round-trip
+            UnrecognizedChunk preserved;
+            preserved.chunkType  = chunkType;
+            preserved.endianness = chunkEndian;
+            if (chunkStartPos + static_cast<size_t>(entry.totalSize) > fileSize)
             {
-                uint8_t numPlanes = bufParse.ParseByte();
-                std::vector<Plane2> planes;
-                for (int j = 0; j < static_cast<int>(numPlanes); ++j)
-                {
-                    planes.push_back(bufParse.ParsePlane2());
-                }
-                tempConvexes[i]->m_convexHull = ConvexHull2(planes);
+                addLine(DevConsole::ERROR, "Error: Chunk size exceeds buffer");
+                return false;
             }
+            preserved.rawData.assign(fileData + chunkStartPos, fileData + chunkStartPos + entry.totalSize);
+            tempPreservedChunks.push_back(preserved);
         }
-        else if (chunkType == 0x81) // BoundingDiscs
+
+        // Validate chunk footer
+        bufParse.SetCurrentPosition(dataStartPos + static_cast<size_t>(dataSize));
+        if (bufParse.ParseChar() != 'E' || bufParse.ParseChar() != 'N' ||
+            bufParse.ParseChar() != 'D' || bufParse.ParseChar() != 'C')
         {
-            hasBoundingDiscs = true;
-            uint16_t numObjects = bufParse.ParseUshort();
-            for (int i = 0; i < static_cast<int>(numObjects) && i < static_cast<int>(tempConvexes.size()); ++i)
-            {
-                tempConvexes[i]->m_boundingDiscCenter = bufParse.ParseVec2();
-                tempConvexes[i]->m_boundingRadius     = bufParse.ParseFloat();
-            }
+            addLine(DevConsole::ERROR, Stringf("Error: Missing ENDC footer for chunk type 0x%02X", chunkType));
+            return false;
         }
-        else if (chunkType == 0x82) // BoundingAABBs
+    }
+
+    // --- Validation ---
+    if (!hasConvexPolys)
+    {
+        addLine(DevConsole::ERROR, "Error: No ConvexPolys chunk found");
+        return false;
+    }
+
+    // --- Decode chunks, concurrently on the JobSystem when the caller may wait on it ---
+    setStage(eSceneLoadStage::DECODING);
+    tempConvexes.reserve(numConvexesToCreate);
+    for (int i = 0; i < numConvexesToCreate; ++i)
+    {
+        tempConvexes.push_back(tempPool.Create());
+    }
+
+    std::vector<SceneChunkDecodeJob*> decodeJobs;
+    decodeJobs.reserve(pendingChunks.size());
+    for (PendingChunk const& pending : pendingChunks)
+    {
+        decodeJobs.push_back(new SceneChunkDecodeJob(pending.type, pending.endian, wideIndices, fileData + pending.dataStartPos, pending.dataSize,
+                                                     tempConvexes, pending.firstConvexIndex, sceneBounds));
+    }
+
+    if (out_progress != nullptr) out_progress->m_numChunks = static_cast<int>(decodeJobs.size());
+
+    auto decodeStartTime = std::chrono::steady_clock::now();
+    if (decodeOnJobSystem)
+    {
+        RunSceneChunkJobs(decodeJobs);
+    }
+    else
+    {
+        for (SceneChunkDecodeJob* job : decodeJobs)
         {
-            hasBoundingAABBs = true;
-            uint16_t numObjects = bufParse.ParseUshort();
-            for (int i = 0; i < static_cast<int>(numObjects) && i < static_cast<int>(tempConvexes.size()); ++i)
-            {
-                tempConvexes[i]->m_boundingAABB = bufParse.ParseAABB2();
-            }
+            job->Execute();
+            if (out_progress != nullptr) ++out_progress->m_numChunksDecoded;
         }
-        else if (chunkType == 0x83) // AABB2 Tree (BVH)
+    }
+    double decodeWallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - decodeStartTime).count();
+
+    // --- Resolve object indices now that every convex is decoded ---
+    // Restored BVHs go to the member matching their build method; leaf ranges are derived here, before the
+    // scene is replaced, so a broken tree only costs a rebuild
+    AABB2Tree         tempAABB2Tree;
+    AABB2Tree         tempAABB2TreeSAH;
+    SymmetricQuadTree tempSymQuadTree;
+    bool   hasMidpointTree    = false;
+    bool   hasSAHTree         = false;
+    bool   hasPolyDecodeError = false;
+    double bvhRestoreMs       = 0.0;
+    double decodeSumMs        = 0.0;
+    for (SceneChunkDecodeJob* job : decodeJobs)
+    {
+        decodeSumMs += job->m_decodeMs;
+        addLine(DevConsole::INFO_MINOR, Stringf("  chunk 0x%02X: %u bytes decoded in %.3fms",
+                                                job->m_chunkType, job->m_dataSize, job->m_decodeMs));
+        if (!job->m_decodeError.empty() && job->m_chunkType == 0x03)
         {
-            hasAABB2Tree = true;
-            uint8_t depthFlag = bufParse.ParseByte();
-            UNUSED(depthFlag);
-            unsigned int numNodes = bufParse.ParseUint32();
-            tempAABB2Tree.m_nodes.resize(numNodes);
-            for (unsigned int n = 0; n < numNodes; ++n)
-            {
-                tempAABB2Tree.m_nodes[n].m_bounds = bufParse.ParseAABB2();
-                int leftChildIdx  = bufParse.ParseInt32();
-                int rightChildIdx = bufParse.ParseInt32();
-                UNUSED(leftChildIdx); UNUSED(rightChildIdx);
-                unsigned int numConvex = bufParse.ParseUint32();
-                for (unsigned int c = 0; c < numConvex; ++c)
-                {
-                    uint16_t objIdx = bufParse.ParseUshort();
-                    if (objIdx < static_cast<uint16_t>(tempConvexes.size()))
-                    {
-                        tempAABB2Tree.m_nodes[n].m_containingConvex.push_back(tempConvexes[objIdx]);
-                    }
-                }
-            }
+            // Vertices cannot be rebuilt, so the whole load fails once every job is deleted
+            addLine(DevConsole::ERROR, Stringf("Error: chunk 0x03 rejected (%s)", job->m_decodeError.c_str()));
+            hasPolyDecodeError = true;
         }
-        else if (chunkType == 0x87) // Symmetric Quadtree (QuadKey format)
+        else if (!job->m_decodeError.empty())
         {
-            hasSymQuadTree = true;
-            unsigned int numEntries = bufParse.ParseUint32();
-
-            size_t savedPos = bufParse.GetCurrentPosition();
-            int maxDepth = 0;
-            for (unsigned int e = 0; e < numEntries; ++e)
+            addLine(DevConsole::WARNING, Stringf("Warning: chunk 0x%02X rejected (%s), rebuilding", job->m_chunkType, job->m_decodeError.c_str()));
+            if (job->m_chunkType == 0x87) hasSymQuadTree = false;
+        }
+        else if (job->m_chunkType == 0x83)
+        {
+            auto restoreStartTime = std::chrono::steady_clock::now();
+            std::vector<std::vector<Convex2*>> leafContents;
+            ResolveNodeObjectIndices(job->m_nodeObjectIndices, tempConvexes, leafContents);
+            AABB2Tree& tree = job->m_AABB2Tree;
+            if (!job->m_hasStoredTreeLayout)
             {
-                uint8_t entryDepth = bufParse.ParseByte();
-                if (static_cast<int>(entryDepth) > maxDepth) maxDepth = static_cast<int>(entryDepth);
-                bufParse.ParseUshort();
-                bufParse.ParseUshort();
-                uint16_t numConvex = bufParse.ParseUshort();
-                for (int c = 0; c < static_cast<int>(numConvex); ++c) bufParse.ParseUshort();
+                InferAABB2TreeLayout_GCS(tree);
             }
-
-            int totalNodes = 0;
-            { int ls = 1; for (int d = 0; d <= maxDepth; ++d) { totalNodes += ls; ls *= 4; } }
-            tempSymQuadTree.m_nodes.resize(totalNodes);
-
-            // Reconstruct bounds
+            if (tree.SetLeafContents(leafContents))
             {
-                Vec2 worldMins = sceneBounds.m_mins;
-                Vec2 worldSize = Vec2(sceneBounds.m_maxs.x - sceneBounds.m_mins.x, sceneBounds.m_maxs.y - sceneBounds.m_mins.y);
-                int levelStart2 = 0;
-                int levelSize2  = 1;
-                for (int d = 0; d <= maxDepth; ++d)
+                if (tree.GetBuildMethod() == eAABB2TreeBuildMethod::SAH)
                 {
-                    int gridDim = 1 << d;
-                    Vec2 cellSize = Vec2(worldSize.x / static_cast<float>(gridDim), worldSize.y / static_cast<float>(gridDim));
-                    for (int j = 0; j < levelSize2 && (levelStart2 + j) < totalNodes; ++j)
-                    {
-                        int gx = j % gridDim;
-                        int gy = j / gridDim;
-                        Vec2 mins = worldMins + Vec2(static_cast<float>(gx) * cellSize.x, static_cast<float>(gy) * cellSize.y);
-                        tempSymQuadTree.m_nodes[levelStart2 + j].m_bounds = AABB2(mins, mins + cellSize);
-                    }
-                    levelStart2 += levelSize2;
-                    levelSize2 *= 4;
-                }
-            }
-
-            // Populate convex references
-            bufParse.SetCurrentPosition(savedPos);
-            for (unsigned int e = 0; e < numEntries; ++e)
-            {
-                uint8_t entryDepth = bufParse.ParseByte();
-                uint16_t qx = bufParse.ParseUshort();
-                uint16_t qy = bufParse.ParseUshort();
-                int levelStart2 = 0;
-                { int ls = 1; for (int d = 0; d < static_cast<int>(entryDepth); ++d) { levelStart2 += ls; ls *= 4; } }
-                int gridDim = 1 << entryDepth;
-                int nodeIdx = levelStart2 + static_cast<int>(qy) * gridDim + static_cast<int>(qx);
-                uint16_t numConvex = bufParse.ParseUshort();
-                if (nodeIdx < totalNodes)
-                {
-                    for (int c = 0; c < static_cast<int>(numConvex); ++c)
-                    {
-                        uint16_t objIdx = bufParse.ParseUshort();
-                        if (objIdx < static_cast<uint16_t>(tempConvexes.size()))
-                            tempSymQuadTree.m_nodes[nodeIdx].m_containingConvex.push_back(tempConvexes[objIdx]);
-                    }
+                    tempAABB2TreeSAH = std::move(tree);
+                    hasSAHTree       = true;
                 }
                 else
                 {
-                    for (int c = 0; c < static_cast<int>(numConvex); ++c) bufParse.ParseUshort();
+                    tempAABB2Tree   = std::move(tree);
+                    hasMidpointTree = true;
                 }
             }
+            else
+            {
+                addLine(DevConsole::WARNING, "Warning: AABB2 tree in scene file is not a valid tree or is too deep, rebuilding");
+            }
+            bvhRestoreMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - restoreStartTime).count();
         }
-        else
-        {
-            // Preserve unrecognized chunks for round-trip
-            UnrecognizedChunk preserved;
-            preserved.chunkType  = chunkType;
-            preserved.endianness = chunkEndian;
-            preserved.rawData.assign(buffer.begin() + chunkStartPos, buffer.begin() + chunkStartPos + entry.totalSize);
-            tempPreservedChunks.push_back(preserved);
-            bufParse.SetCurrentPosition(dataStartPos + static_cast<size_t>(dataSize));
-        }
-
-        // Validate chunk footer
-        if (bufParse.ParseChar() != 'E' || bufParse.ParseChar() != 'N' ||
-            bufParse.ParseChar() != 'D' || bufParse.ParseChar() != 'C')
+        else if (job->m_chunkType == 0x87)
         {
-            g_devConsole->AddLine(DevConsole::ERROR, Stringf("Error: Missing ENDC footer for chunk type 0x%02X", chunkType));
-            for (Convex2* c : tempConvexes) delete c;
-            return false;
+            std::vector<std::vector<Convex2*>> cellContents;
+            ResolveNodeObjectIndices(job->m_nodeObjectIndices, tempConvexes, cellContents);
+            tempSymQuadTree = std::move(job->m_symQuadTree);
+            for (size_t n = 0; n < cellContents.size(); ++n)
+            {
+                tempSymQuadTree.m_nodes[n].m_containingConvex = std::move(cellContents[n]);
+            }
         }
+        delete job;
     }
-
-    // --- Validation ---
-    if (!hasConvexPolys)
+    addLine(DevConsole::INFO_MINOR, Stringf("Decoded %d chunks in %.2fms wall vs %.2fms summed (%.2fms saved)",
+                                            static_cast<int>(decodeJobs.size()), decodeWallMs, decodeSumMs,
+                                            decodeSumMs - decodeWallMs));
+    if (hasPolyDecodeError)
     {
-        g_devConsole->AddLine(DevConsole::ERROR, "Error: No ConvexPolys chunk found");
-        for (Convex2* c : tempConvexes) delete c;
         return false;
     }
 
@@ -1507,18 +1834,62 @@ bool GameConvexScene::LoadSceneFromFile(std::string const& filePath)
             convex->RebuildBoundingVolumes();
     }
 
-    // --- Replace current scene ---
+    // --- Build whatever the file did not carry, still away from the running scene ---
+    setStage(eSceneLoadStage::BUILDING);
+    auto buildStartTime = std::chrono::steady_clock::now();
+    if (!hasMidpointTree || !hasSymQuadTree)
+    {
+        AABB2 totalBounds = hasSceneInfo ? sceneBounds : fallbackBounds;
+        int bvhDepth = GetDefaultAABB2TreeDepth(static_cast<int>(tempConvexes.size()));
+        if (!hasMidpointTree) tempAABB2Tree.BuildTree(tempConvexes, bvhDepth, totalBounds);
+        if (!hasSymQuadTree) tempSymQuadTree.BuildTree(tempConvexes, 4, totalBounds);
+    }
+    if (!hasSAHTree) tempAABB2TreeSAH.BuildTreeSAH(tempConvexes);
+    double buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - buildStartTime).count();
+    out_loadedScene.m_convexStore.Build(tempConvexes);
+    out_loadedScene.m_uniformGrid.BuildGrid(tempConvexes);
+
+    int numRestoredBVHs = (hasMidpointTree ? 1 : 0) + (hasSAHTree ? 1 : 0);
+    addLine(DevConsole::INFO_MINOR, Stringf("  %d of 2 BVHs restored from chunk 0x83 in %.2fms, missing structures built in %.2fms",
+                                            numRestoredBVHs, bvhRestoreMs, buildMs));
+
+    out_loadedScene.m_convexPool      = std::move(tempPool);
+    out_loadedScene.m_convexes        = std::move(tempConvexes);
+    out_loadedScene.m_preservedChunks = std::move(tempPreservedChunks);
+    out_loadedScene.m_sceneBounds     = sceneBounds;
+    out_loadedScene.m_hasSceneInfo    = hasSceneInfo;
+    out_loadedScene.m_AABB2Tree       = std::move(tempAABB2Tree);
+    out_loadedScene.m_AABB2TreeSAH    = std::move(tempAABB2TreeSAH);
+    out_loadedScene.m_symQuadTree     = std::move(tempSymQuadTree);
+    out_loadedScene.m_bvhRestoreMs    = bvhRestoreMs;
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Only moves: the pool, its convexes and every structure that points into it were built by ParseSceneFile
+//----------------------------------------------------------------------------------------------------
+void GameConvexScene::ApplyLoadedScene(LoadedConvexScene& loadedScene)
+{
     ClearScene();
-    m_convexes = std::move(tempConvexes);
-    m_preservedChunks = std::move(tempPreservedChunks);
+    m_convexPool      = std::move(loadedScene.m_convexPool);
+    m_convexes        = std::move(loadedScene.m_convexes);
+    m_preservedChunks = std::move(loadedScene.m_preservedChunks);
+    m_AABB2Tree       = std::move(loadedScene.m_AABB2Tree);
+    m_AABB2TreeSAH    = std::move(loadedScene.m_AABB2TreeSAH);
+    m_symQuadTree     = std::move(loadedScene.m_symQuadTree);
+    m_convexStore     = std::move(loadedScene.m_convexStore);
+    m_uniformGrid     = std::move(loadedScene.m_uniformGrid);
+    m_lastBVHRestoreMs = loadedScene.m_bvhRestoreMs;
+    RebuildHoverOrder();
     m_sceneModified = false;
 
     // Adjust camera to scene bounds
-    if (hasSceneInfo)
+    if (loadedScene.m_hasSceneInfo)
     {
         m_hasLoadedScene = true;
-        m_loadedSceneBounds = sceneBounds;
+        m_loadedSceneBounds = loadedScene.m_sceneBounds;
 
+        AABB2 const& sceneBounds = loadedScene.m_sceneBounds;
         float sceneWidth  = sceneBounds.m_maxs.x - sceneBounds.m_mins.x;
         float sceneHeight = sceneBounds.m_maxs.y - sceneBounds.m_mins.y;
         float sceneAspect = sceneWidth / sceneHeight;
@@ -1542,38 +1913,91 @@ bool GameConvexScene::LoadSceneFromFile(std::string const& filePath)
                 Vec2(sceneBounds.m_maxs.x + offsetX, sceneBounds.m_maxs.y));
         }
     }
+}
 
-    // Restore or rebuild spatial acceleration structures
-    if (hasAABB2Tree)
+//----------------------------------------------------------------------------------------------------
+bool GameConvexScene::LoadSceneFromFile(std::string const& filePath)
+{
+    LoadedConvexScene loadedScene;
+    bool const parsed = ParseSceneFile(filePath, GetWorldBounds(), true, loadedScene);
+    PrintSceneLoadMessages_GCS(loadedScene);
+    if (!parsed) return false;
+
+    ApplyLoadedScene(loadedScene);
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// The whole load runs on the I/O thread; UpdateAsyncSceneLoad swaps the result in once it completes
+//----------------------------------------------------------------------------------------------------
+bool GameConvexScene::BeginAsyncSceneLoad(std::string const& filePath)
+{
+    if (IsAsyncSceneLoadInFlight()) return false;
+
+    m_asyncLoadJob          = new ConvexSceneLoadJob(filePath, GetWorldBounds());
+    m_reportedLoadStage     = eSceneLoadStage::QUEUED;
+    m_reportedChunksDecoded = 0;
+    m_wasSceneModifiedBeforeAsyncLoad = m_sceneModified;
+    m_sceneModified         = false;
+    g_jobSystem->SubmitJob(m_asyncLoadJob);
+    g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("Loading %s in the background, current scene stays live until it is replaced", filePath.c_str()));
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Polled once per frame. Reports stage changes, then on completion prints the job's queued lines and
+// replaces the scene; the swap is moves only, so the frame it lands on costs about one ClearScene.
+//----------------------------------------------------------------------------------------------------
+void GameConvexScene::UpdateAsyncSceneLoad()
+{
+    if (!IsAsyncSceneLoadInFlight()) return;
+
+    SceneLoadProgress const& progress = m_asyncLoadJob->m_progress;
+    eSceneLoadStage const    stage    = progress.m_stage;
+    int const numChunksDecoded = progress.m_numChunksDecoded;
+    if (stage != eSceneLoadStage::DONE && (stage != m_reportedLoadStage || numChunksDecoded != m_reportedChunksDecoded))
+    {
+        m_reportedLoadStage     = stage;
+        m_reportedChunksDecoded = numChunksDecoded;
+        if (stage == eSceneLoadStage::DECODING)
+            g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  %s: %s, %d of %d done", m_asyncLoadJob->m_filePath.c_str(),
+                                                                  GetSceneLoadStageName_GCS(stage), numChunksDecoded, progress.m_numChunks.load()));
+        else
+            g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  %s: %s", m_asyncLoadJob->m_filePath.c_str(), GetSceneLoadStageName_GCS(stage)));
+    }
+
+    // Every other JobSystem user in this mode blocks until it has retrieved its own jobs, so nothing else is outstanding
+    Job* completedJob = g_jobSystem->RetrieveCompletedJob();
+    if (completedJob == nullptr) return;
+    GUARANTEE_OR_DIE(completedJob == m_asyncLoadJob, "Unexpected job completed during an async scene load");
+
+    ConvexSceneLoadJob* loadJob = m_asyncLoadJob;
+    m_asyncLoadJob = nullptr;
+
+    PrintSceneLoadMessages_GCS(loadJob->m_loadedScene);
+    if (loadJob->m_succeeded)
     {
-        int numNodes = static_cast<int>(tempAABB2Tree.m_nodes.size());
-        int lastLevelStart = 0;
-        int levelSize = 1;
-        while (lastLevelStart + levelSize < numNodes)
+        double loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loadJob->m_submitTime).count();
+        if (m_sceneModified)
         {
-            lastLevelStart += levelSize;
-            levelSize *= 2;
+            g_devConsole->AddLine(DevConsole::WARNING, Stringf("Warning: %s replaced the current scene, edits made while it loaded were discarded",
+                                                               loadJob->m_filePath.c_str()));
         }
-        tempAABB2Tree.SetStartOfLastLevel(lastLevelStart);
-        m_AABB2Tree = std::move(tempAABB2Tree);
-    }
-    if (hasSymQuadTree)
-    {
-        m_symQuadTree = std::move(tempSymQuadTree);
+
+        auto swapStartTime = std::chrono::steady_clock::now();
+        ApplyLoadedScene(loadJob->m_loadedScene);
+        double swapMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - swapStartTime).count();
+
+        double fileMB = static_cast<double>(loadJob->m_loadedScene.m_fileSize) / (1024.0 * 1024.0);
+        g_devConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("Loaded scene from %s", loadJob->m_filePath.c_str()));
+        g_devConsole->AddLine(DevConsole::INFO_MINOR, Stringf("%d convexes, %.2f MB in %.2fms in the background, swapped in at a frame boundary in %.2fms",
+                                                              m_convexPool.GetNumLiveConvexes(), fileMB, loadMs, swapMs));
     }
-    if (!hasAABB2Tree || !hasSymQuadTree)
+    else
     {
-        AABB2 totalBounds = GetWorldBounds();
-        int numConvexes = static_cast<int>(m_convexes.size());
-        int bvhDepth = 0;
-        if (numConvexes > 0)
-        {
-            bvhDepth = static_cast<int>(log2(static_cast<double>(numConvexes))) - 3;
-            if (bvhDepth < 3) bvhDepth = 3;
-        }
-        if (!hasAABB2Tree) m_AABB2Tree.BuildTree(m_convexes, bvhDepth, totalBounds);
-        if (!hasSymQuadTree) m_symQuadTree.BuildTree(m_convexes, 4, totalBounds);
+        // The current scene stays, so it is unsaved if it was before the load or has been edited since
+        m_sceneModified = m_sceneModified || m_wasSceneModifiedBeforeAsyncLoad;
     }
-
-    return true;
+    m_wasSceneModifiedBeforeAsyncLoad = false;
+    delete loadJob;
 }
@@ -6,13 +6,21 @@
 #pragma once
 #include "Game/Game.hpp"
 #include "Game/BVH.hpp"
+#include "Game/ConvexPool.hpp"
+#include "Game/ConvexSceneStore.hpp"
 #include "Game/QuadTree.hpp"
+#include "Game/RayBenchmark.hpp"
+#include "Game/SceneHash.hpp"
+#include "Game/UniformGrid.hpp"
 #include "Engine/Core/EventSystem.hpp"
 #include "Engine/Core/Rgba8.hpp"
 //----------------------------------------------------------------------------------------------------
+#include <atomic>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+class ConvexSceneLoadJob;
 struct Convex2;
 struct ConvexPoly2;
 struct Vertex_PCU;
@@ -25,6 +33,55 @@ struct UnrecognizedChunk
     std::vector<uint8_t> rawData;
 };
 
+//----------------------------------------------------------------------------------------------------
+// Everything a GHCS load produces before it replaces the scene. ParseSceneFile fills it without touching
+// the game or the DevConsole, so it can run off the main thread; its console lines wait in m_messages.
+//----------------------------------------------------------------------------------------------------
+struct SceneLoadMessage
+{
+    Rgba8       m_color;
+    std::string m_text;
+};
+
+struct LoadedConvexScene
+{
+    ConvexPool                     m_convexPool;
+    std::vector<Convex2*>          m_convexes;
+    std::vector<UnrecognizedChunk> m_preservedChunks;
+    AABB2                          m_sceneBounds;
+    bool                           m_hasSceneInfo = false;
+    size_t                         m_fileSize     = 0;   // Bytes mapped by the loader, reported once the load completes
+
+    // Restored from the file or built for the loaded convexes
+    AABB2Tree         m_AABB2Tree;
+    AABB2Tree         m_AABB2TreeSAH;
+    SymmetricQuadTree m_symQuadTree;
+    ConvexSceneStore  m_convexStore;
+    UniformGrid2D     m_uniformGrid;
+    double            m_bvhRestoreMs = 0.0;
+
+    std::vector<SceneLoadMessage> m_messages;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Written by the loading thread, polled by the main thread for DevConsole progress
+//----------------------------------------------------------------------------------------------------
+enum class eSceneLoadStage : uint8_t
+{
+    QUEUED,
+    VALIDATING,     // Header, hash, ToC and chunk framing
+    DECODING,       // Chunk payloads
+    BUILDING,       // Spatial structures the file did not carry
+    DONE
+};
+
+struct SceneLoadProgress
+{
+    std::atomic<eSceneLoadStage> m_stage            = eSceneLoadStage::QUEUED;
+    std::atomic<int>             m_numChunks        = 0;
+    std::atomic<int>             m_numChunksDecoded = 0;
+};
+
 //----------------------------------------------------------------------------------------------------
 class GameConvexScene final : public Game
 {
@@ -38,11 +95,19 @@ public:
     //------------------------------------------------------------------------------------------------
     // Save / Load (dev console commands)
     //------------------------------------------------------------------------------------------------
-    bool SaveSceneToFile(std::string const& filePath);
+    bool SaveSceneToFile(std::string const& filePath, eGHCSHashType hashType = eGHCSHashType::XXHASH64, bool quantizeGeometry = false);
     bool LoadSceneFromFile(std::string const& filePath);
+    bool BeginAsyncSceneLoad(std::string const& filePath);
+    bool IsAsyncSceneLoadInFlight() const { return m_asyncLoadJob != nullptr; }
+
+    // Reads and decodes a GHCS file into out_loadedScene. decodeOnJobSystem spreads the chunk decode over the
+    // generic workers, which only the main thread may wait on; a job runs it with false and decodes inline.
+    static bool ParseSceneFile(std::string const& filePath, AABB2 const& fallbackBounds, bool decodeOnJobSystem,
+                               LoadedConvexScene& out_loadedScene, SceneLoadProgress* out_progress = nullptr);
 
     static bool SaveConvexSceneCommand(EventArgs& args);
     static bool LoadConvexSceneCommand(EventArgs& args);
+    static bool GenerateConvexSceneCommand(EventArgs& args);
 
 private:
     void UpdateFromKeyboard(float deltaSeconds) override;
@@ -51,13 +116,17 @@ private:
     //------------------------------------------------------------------------------------------------
     // Convex generation
     //------------------------------------------------------------------------------------------------
-    static Convex2* CreateRandomConvex(Vec2 const& center, float minRadius, float maxRadius);
+    Convex2* CreateRandomConvex(Vec2 const& center, float minRadius, float maxRadius);
 
     //------------------------------------------------------------------------------------------------
     // Scene management
     //------------------------------------------------------------------------------------------------
     void RebuildAllTrees();
+    void RebuildHoverOrder();
+    void RefitTreesForConvex(Convex2* convex, AABB2 const& oldBounds);
     void ClearScene();
+    void ApplyLoadedScene(LoadedConvexScene& loadedScene);
+    void UpdateAsyncSceneLoad();
 
     //------------------------------------------------------------------------------------------------
     // Interaction
@@ -82,39 +151,55 @@ private:
     //------------------------------------------------------------------------------------------------
     // Member variables
     //------------------------------------------------------------------------------------------------
-    // Convex objects
+    // Convex objects (m_convexPool owns them; m_convexes is the scene order)
+    ConvexPool            m_convexPool;
     std::vector<Convex2*> m_convexes;
+    ConvexSceneStore      m_convexStore;    // SoA copy of m_convexes for the linear sweeps (TestRays, F9 sweep modes)
 
     // Interaction state
     Convex2* m_hoveringConvex = nullptr;
+    std::unordered_map<Convex2 const*, int> m_hoverOrder;       // Index in m_convexes (and m_convexStore): among overlapping convexes the last drawn wins
+    std::vector<Convex2*>                   m_hoverCandidates;  // Scratch for the per-frame BVH point query
     Vec2     m_cursorPrevPos;
     bool     m_isDragging    = false;
     bool     m_drawEdgesMode = false;
     bool     m_showBoundingDiscs = false;
     bool     m_showSpatialStructure = false;
     bool     m_debugDrawBVHMode     = false;
-    int      m_rayOptimizationMode = 0; // 0=None, 1=Disc, 2=AABB
+    bool     m_debugDrawGridMode    = false;
+    int      m_rayOptimizationMode = 0; // 0=None, 1=Disc, 2=AABB, 3=Disc sweep, 4=AABB sweep (SoA store)
 
     // Raycast testing
     Vec2 m_rayStart;
     Vec2 m_rayEnd;
     int  m_numOfRandomRays = 1024;
+    bool m_parallelRayTest = false; // J: also run each strategy chunked on the JobSystem
 
     // Performance metrics
-    float m_avgDist                      = 0.f;
-    float m_lastRayTestNormalTime        = 0.f;
-    float m_lastRayTestDiscRejectionTime = 0.f;
-    float m_lastRayTestAABBRejectionTime = 0.f;
-    float m_lastRayTestSymmetricTreeTime = 0.f;
-    float m_lastRayTestAABBTreeTime      = 0.f;
+    float                          m_avgDist = 0.f;
+    std::vector<RayStrategyResult> m_lastRayTestResults;
 
     // Spatial structures
     SymmetricQuadTree m_symQuadTree;
-    AABB2Tree         m_AABB2Tree;
+    AdaptiveQuadTree  m_adaptiveQuadTree;   // Regular and loose builds, compared against the fixed pyramid in TestRays
+    AdaptiveQuadTree  m_looseQuadTree;
+    AABB2Tree         m_AABB2Tree;      // Midpoint build (saved to chunk 0x83, drawn with F3)
+    AABB2Tree         m_AABB2TreeSAH;   // SAH build (also saved to chunk 0x83), compared against the midpoint build in TestRays
+    AABB2Tree4        m_AABB2Tree4SAH;  // BVH4 collapsed from m_AABB2TreeSAH for the 4-wide slab test
+    UniformGrid2D     m_uniformGrid;    // DDA-walked grid compared against the trees in TestRays, drawn with F5
 
     // Scene persistence
     AABB2 m_loadedSceneBounds;
     bool  m_hasLoadedScene = false;
     std::vector<UnrecognizedChunk> m_preservedChunks;
     bool m_sceneModified = false;
+    double m_lastBVHRestoreMs = 0.0;   // Time the last load spent restoring BVHs from chunk 0x83
+
+    // Async load (LoadConvexScene async=true): the current scene stays live until the job completes.
+    // m_sceneModified restarts at false when the load begins, so on completion it tells whether the
+    // scene was edited meanwhile; the flag from before the load is kept here (and counts for saves) until it ends.
+    ConvexSceneLoadJob* m_asyncLoadJob = nullptr;
+    eSceneLoadStage     m_reportedLoadStage = eSceneLoadStage::QUEUED;
+    int                 m_reportedChunksDecoded = 0;
+    bool                m_wasSceneModifiedBeforeAsyncLoad = false;
 };
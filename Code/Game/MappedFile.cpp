@@ -0,0 +1,88 @@
+//----------------------------------------------------------------------------------------------------
+// MappedFile.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/MappedFile.hpp"
+//----------------------------------------------------------------------------------------------------
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN     // Always #define this before #including <windows.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//----------------------------------------------------------------------------------------------------
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+//----------------------------------------------------------------------------------------------------
+// The file and mapping handles are closed as soon as the view exists; the view keeps the file alive.
+//----------------------------------------------------------------------------------------------------
+bool MappedFile::Open(std::string const& filePath)
+{
+	Close();
+
+#if defined(_WIN32)
+	HANDLE fileHandle = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (fileHandle == INVALID_HANDLE_VALUE) return false;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0)
+	{
+		CloseHandle(fileHandle);
+		return false;
+	}
+
+	HANDLE mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(fileHandle);
+	if (mappingHandle == nullptr) return false;
+
+	void* view = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mappingHandle);
+	if (view == nullptr) return false;
+
+	m_data = static_cast<unsigned char const*>(view);
+	m_size = static_cast<size_t>(fileSize.QuadPart);
+#else
+	int fileDescriptor = open(filePath.c_str(), O_RDONLY);
+	if (fileDescriptor < 0) return false;
+
+	struct stat fileStat;
+	if (fstat(fileDescriptor, &fileStat) != 0 || fileStat.st_size <= 0)
+	{
+		close(fileDescriptor);
+		return false;
+	}
+
+	void* view = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+	close(fileDescriptor);
+	if (view == MAP_FAILED) return false;
+
+	// The loader walks the file front to back, so ask for aggressive read-ahead
+	madvise(view, static_cast<size_t>(fileStat.st_size), MADV_SEQUENTIAL);
+
+	m_data = static_cast<unsigned char const*>(view);
+	m_size = static_cast<size_t>(fileStat.st_size);
+#endif
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void MappedFile::Close()
+{
+	if (m_data == nullptr) return;
+
+#if defined(_WIN32)
+	UnmapViewOfFile(m_data);
+#else
+	munmap(const_cast<unsigned char*>(m_data), m_size);
+#endif
+	m_data = nullptr;
+	m_size = 0;
+}
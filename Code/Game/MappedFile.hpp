@@ -0,0 +1,36 @@
+//----------------------------------------------------------------------------------------------------
+// MappedFile.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include <cstddef>
+#include <string>
+
+//----------------------------------------------------------------------------------------------------
+// MappedFile - Read-only memory mapping of a whole file (mmap on Linux, MapViewOfFile on Windows).
+//
+// Parsers read the file straight from the mapped pages, so loading does not copy it into a buffer
+// first; the OS pages it in as the parser touches it. The mapping lives until Close or destruction.
+//----------------------------------------------------------------------------------------------------
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	MappedFile(MappedFile const&)            = delete;
+	MappedFile& operator=(MappedFile const&) = delete;
+	~MappedFile();
+
+	// False when the file is missing, empty or cannot be mapped
+	bool Open(std::string const& filePath);
+	void Close();
+
+	bool                 IsOpen() const { return m_data != nullptr; }
+	unsigned char const* GetData() const { return m_data; }
+	size_t               GetSize() const { return m_size; }
+
+private:
+	unsigned char const* m_data = nullptr;
+	size_t               m_size = 0;
+};
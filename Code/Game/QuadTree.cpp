@@ -5,10 +5,19 @@
 //----------------------------------------------------------------------------------------------------
 #include "Game/Convex.hpp"
 #include "Game/QuadTree.hpp"
+#include "Game/RaySlab.hpp"
 
+#include "Engine/Core/ErrorWarningAssert.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Math/RaycastUtils.hpp"
 
+#include <algorithm>
+#include <cstdint>
+
+//----------------------------------------------------------------------------------------------------
+// A depth-first walk holds at most 3 siblings per level passed plus the 4 children of the deepest cell
+constexpr int SYMMETRIC_QT_STACK_SIZE = 3 * MAX_SYMMETRIC_QUAD_TREE_LEVELS + 1;
+
 //----------------------------------------------------------------------------------------------------
 static int IntPow_QT(int x, unsigned int p)
 {
@@ -50,6 +59,7 @@ static AABB2 ComputeChildBounds(AABB2 const& parentBounds, int childIndex, int p
 void SymmetricQuadTree::BuildTree(std::vector<Convex2*> const& convexArray, int numOfRecursive, AABB2 const& totalBounds)
 {
 	m_nodes.clear();
+	numOfRecursive = std::min(numOfRecursive, MAX_SYMMETRIC_QUAD_TREE_LEVELS);
 
 	int numOfNodes = 0;
 	for (int i = 0; i < numOfRecursive; ++i)
@@ -93,35 +103,62 @@ void SymmetricQuadTree::BuildTree(std::vector<Convex2*> const& convexArray, int
 }
 
 //----------------------------------------------------------------------------------------------------
-static bool RayHitsAABB2D_QT(Vec2 const& startPos, Vec2 const& forwardVec, float maxDist, AABB2 const& bounds)
+// Keeps the first occurrence of every convex in convexes[firstIndex, end), preserving order. Uses a
+// per-thread open-addressing table sized to the range, so the cost follows the candidate count.
+//----------------------------------------------------------------------------------------------------
+static void RemoveDuplicates_QT(std::vector<Convex2*>& convexes, size_t const firstIndex)
 {
-	RaycastResult2D result = RaycastVsAABB2D(startPos, forwardVec, maxDist, bounds.m_mins, bounds.m_maxs);
-	return result.m_didImpact;
+	thread_local std::vector<Convex2*> s_table;
+
+	size_t const numCandidates = convexes.size() - firstIndex;
+	if (numCandidates < 2)
+	{
+		return;
+	}
+
+	size_t tableSize = 16;
+	while (tableSize < numCandidates * 2)
+	{
+		tableSize *= 2;
+	}
+	s_table.assign(tableSize, nullptr);
+	size_t const mask = tableSize - 1;
+
+	size_t writeIndex = firstIndex;
+	for (size_t readIndex = firstIndex; readIndex < convexes.size(); ++readIndex)
+	{
+		Convex2* convex = convexes[readIndex];
+		size_t   slot   = static_cast<size_t>(((reinterpret_cast<uintptr_t>(convex) >> 4) * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+		while (s_table[slot] != nullptr && s_table[slot] != convex)
+		{
+			slot = (slot + 1) & mask;
+		}
+		if (s_table[slot] == convex)
+		{
+			continue;
+		}
+		s_table[slot]          = convex;
+		convexes[writeIndex++] = convex;
+	}
+	convexes.resize(writeIndex);
 }
 
 //----------------------------------------------------------------------------------------------------
-void SymmetricQuadTree::SolveRayResult(Vec2 const& startPos, Vec2 const& forwardVec, float maxDist, std::vector<Convex2*> const& convexArray, std::vector<Convex2*>& out_latentRes)
+void SymmetricQuadTree::SolveRayResult(Vec2 const& startPos, Vec2 const& forwardVec, float maxDist, std::vector<Convex2*>& out_latentRes, int* out_numCellsVisited) const
 {
-	for (auto convex : convexArray)
-	{
-		convex->m_symmetricQuadTreeFlag = false;
-	}
+	size_t const    firstNewIndex = out_latentRes.size();
+	RaySlab2D const ray(startPos, forwardVec, maxDist);
+	int             numCellsVisited = 0;
 
 	int ptr = 0;
 	while (ptr < static_cast<int>(m_nodes.size()))
 	{
-		if (RayHitsAABB2D_QT(startPos, forwardVec, maxDist, m_nodes[ptr].m_bounds))
+		if (ray.HitsAABB2(m_nodes[ptr].m_bounds))
 		{
 			if (!m_nodes[ptr].m_containingConvex.empty())
 			{
-				for (auto convex : m_nodes[ptr].m_containingConvex)
-				{
-					if (!convex->m_symmetricQuadTreeFlag)
-					{
-						convex->m_symmetricQuadTreeFlag = true;
-						out_latentRes.push_back(convex);
-					}
-				}
+				++numCellsVisited;
+				out_latentRes.insert(out_latentRes.end(), m_nodes[ptr].m_containingConvex.begin(), m_nodes[ptr].m_containingConvex.end());
 				while (ptr % 4 == 0 && ptr != 0)
 				{
 					ptr = GetParentIndex(ptr);
@@ -134,6 +171,7 @@ void SymmetricQuadTree::SolveRayResult(Vec2 const& startPos, Vec2 const& forward
 				int child = GetFirstLBChild(ptr);
 				if (child >= static_cast<int>(m_nodes.size()))
 				{
+					++numCellsVisited;
 					while (ptr % 4 == 0 && ptr != 0)
 					{
 						ptr = GetParentIndex(ptr);
@@ -157,34 +195,423 @@ void SymmetricQuadTree::SolveRayResult(Vec2 const& startPos, Vec2 const& forward
 			++ptr;
 		}
 	}
+
+	// A convex spanning several cells was appended once per cell; dedup only what this query added
+	RemoveDuplicates_QT(out_latentRes, firstNewIndex);
+
+	if (out_numCellsVisited != nullptr)
+	{
+		*out_numCellsVisited = numCellsVisited;
+	}
+}
+
+//----------------------------------------------------------------------------------------------------
+// A convex spanning several cells may be raycast once per cell; bestDist caps the repeat at the AABB check
+//----------------------------------------------------------------------------------------------------
+Convex2* SymmetricQuadTree::SolveRayClosestHit(Vec2 const& startPos, Vec2 const& forwardVec, float maxDist, RaycastResult2D& out_closestHit, int* out_numCellsVisited) const
+{
+	struct StackEntry
+	{
+		int   m_nodeIndex;
+		float m_entryDist;
+	};
+	out_closestHit.m_didImpact = false;
+	Convex2* closestConvex   = nullptr;
+	float    bestDist        = maxDist;
+	int      numCellsVisited = 0;
+
+	// m_maxDist follows bestDist, so cells behind the best hit stop passing
+	RaySlab2D ray(startPos, forwardVec, bestDist);
+	float     rootEntryDist;
+	if (m_nodes.empty() || !ray.HitsAABB2(m_nodes[0].m_bounds, rootEntryDist))
+	{
+		if (out_numCellsVisited != nullptr) *out_numCellsVisited = 0;
+		return nullptr;
+	}
+
+	StackEntry stack[SYMMETRIC_QT_STACK_SIZE];
+	int        stackSize = 0;
+	stack[stackSize++]   = { 0, rootEntryDist };
+
+	while (stackSize > 0)
+	{
+		StackEntry entry = stack[--stackSize];
+
+		// A closer hit was found after this cell was pushed
+		if (entry.m_entryDist > bestDist)
+		{
+			continue;
+		}
+
+		int const firstChild = GetFirstLBChild(entry.m_nodeIndex);
+		if (firstChild >= static_cast<int>(m_nodes.size()))
+		{
+			++numCellsVisited;
+			RaycastResult2D rayRes;
+			for (Convex2* convex : m_nodes[entry.m_nodeIndex].m_containingConvex)
+			{
+				if (convex->RayCastVsConvex2D<eRayRejection::DISC>(rayRes, ray) && rayRes.m_impactLength <= bestDist)
+				{
+					bestDist       = rayRes.m_impactLength;
+					ray.m_maxDist  = bestDist;
+					out_closestHit = rayRes;
+					closestConvex  = convex;
+				}
+			}
+			continue;
+		}
+
+		// Hit children sorted near to far (insertion sort, at most four), then pushed far to near
+		StackEntry hitChildren[4];
+		int        numHits = 0;
+		for (int child = firstChild; child <= GetForthRTChild(entry.m_nodeIndex); ++child)
+		{
+			float entryDist;
+			if (!ray.HitsAABB2(m_nodes[child].m_bounds, entryDist)) continue;
+			int i = numHits++;
+			while (i > 0 && hitChildren[i - 1].m_entryDist > entryDist)
+			{
+				hitChildren[i] = hitChildren[i - 1];
+				--i;
+			}
+			hitChildren[i] = { child, entryDist };
+		}
+		GUARANTEE_OR_DIE(stackSize + numHits <= SYMMETRIC_QT_STACK_SIZE, "SymmetricQuadTree deeper than MAX_SYMMETRIC_QUAD_TREE_LEVELS");
+		for (int i = numHits - 1; i >= 0; --i)
+		{
+			stack[stackSize++] = hitChildren[i];
+		}
+	}
+
+	if (out_numCellsVisited != nullptr)
+	{
+		*out_numCellsVisited = numCellsVisited;
+	}
+	return closestConvex;
 }
 
 //----------------------------------------------------------------------------------------------------
-int SymmetricQuadTree::GetFirstLBChild(int index)
+void SymmetricQuadTree::UpdateConvex(Convex2* convex, AABB2 const& oldBounds)
+{
+	AABB2 const& newBounds = convex->m_boundingAABB;
+	if (m_nodes.empty())
+	{
+		return;
+	}
+
+	// Descend only into cells touched by the old or the new box
+	int stack[SYMMETRIC_QT_STACK_SIZE];
+	int stackSize      = 0;
+	stack[stackSize++] = 0;
+
+	while (stackSize > 0)
+	{
+		int nodeIndex = stack[--stackSize];
+		SymmetricQuadTreeNode& node = m_nodes[nodeIndex];
+
+		bool wasInside = DoAABB2sOverlap2D(oldBounds, node.m_bounds);
+		bool isInside  = DoAABB2sOverlap2D(newBounds, node.m_bounds);
+		if (!wasInside && !isInside)
+		{
+			continue;
+		}
+
+		int firstChild = GetFirstLBChild(nodeIndex);
+		if (firstChild < static_cast<int>(m_nodes.size()))
+		{
+			GUARANTEE_OR_DIE(stackSize + 4 <= SYMMETRIC_QT_STACK_SIZE, "SymmetricQuadTree deeper than MAX_SYMMETRIC_QUAD_TREE_LEVELS");
+			stack[stackSize++] = GetForthRTChild(nodeIndex);
+			stack[stackSize++] = GetThirdLTChild(nodeIndex);
+			stack[stackSize++] = GetSecondRBChild(nodeIndex);
+			stack[stackSize++] = firstChild;
+			continue;
+		}
+
+		if (wasInside && !isInside)
+		{
+			auto found = std::find(node.m_containingConvex.begin(), node.m_containingConvex.end(), convex);
+			if (found != node.m_containingConvex.end())
+			{
+				node.m_containingConvex.erase(found);
+			}
+		}
+		else if (!wasInside && isInside)
+		{
+			node.m_containingConvex.push_back(convex);
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------
+// A point outside the root is clamped onto it first. Any convex whose AABB holds the point and overlaps
+// the root also holds the clamped point, so it is listed in the leaf found for the clamped point.
+//----------------------------------------------------------------------------------------------------
+void SymmetricQuadTree::SolvePointResult(Vec2 const& point, std::vector<Convex2*>& out_containing) const
+{
+	if (m_nodes.empty())
+	{
+		return;
+	}
+
+	AABB2 const& rootBounds = m_nodes[0].m_bounds;
+	Vec2 const   cellPoint(std::clamp(point.x, rootBounds.m_mins.x, rootBounds.m_maxs.x), std::clamp(point.y, rootBounds.m_mins.y, rootBounds.m_maxs.y));
+
+	// One quadrant per level, picked against the cell center (LB, RB, LT, RT as in ComputeChildBounds)
+	int nodeIndex = 0;
+	while (GetFirstLBChild(nodeIndex) < static_cast<int>(m_nodes.size()))
+	{
+		AABB2 const& bounds = m_nodes[nodeIndex].m_bounds;
+		Vec2 const   center = bounds.m_mins + bounds.GetDimensions() * 0.5f;
+		int const    which  = ((cellPoint.x >= center.x) ? 1 : 0) + ((cellPoint.y >= center.y) ? 2 : 0);
+		nodeIndex = GetFirstLBChild(nodeIndex) + which;
+	}
+
+	for (Convex2* convex : m_nodes[nodeIndex].m_containingConvex)
+	{
+		if (convex->IsPointInside(point))
+		{
+			out_containing.push_back(convex);
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------
+void SymmetricQuadTree::SolvePointBatch(Vec2 const* points, int const numPoints, std::vector<int>& out_firstContaining, std::vector<Convex2*>& out_containing) const
+{
+	out_firstContaining.clear();
+	out_containing.clear();
+	out_firstContaining.reserve(numPoints + 1);
+	for (int i = 0; i < numPoints; ++i)
+	{
+		out_firstContaining.push_back(static_cast<int>(out_containing.size()));
+		SolvePointResult(points[i], out_containing);
+	}
+	out_firstContaining.push_back(static_cast<int>(out_containing.size()));
+}
+
+//----------------------------------------------------------------------------------------------------
+int SymmetricQuadTree::GetFirstLBChild(int index) const
 {
 	return index * 4 + 1;
 }
 
 //----------------------------------------------------------------------------------------------------
-int SymmetricQuadTree::GetSecondRBChild(int index)
+int SymmetricQuadTree::GetSecondRBChild(int index) const
 {
 	return index * 4 + 2;
 }
 
 //----------------------------------------------------------------------------------------------------
-int SymmetricQuadTree::GetThirdLTChild(int index)
+int SymmetricQuadTree::GetThirdLTChild(int index) const
 {
 	return index * 4 + 3;
 }
 
 //----------------------------------------------------------------------------------------------------
-int SymmetricQuadTree::GetForthRTChild(int index)
+int SymmetricQuadTree::GetForthRTChild(int index) const
 {
 	return index * 4 + 4;
 }
 
 //----------------------------------------------------------------------------------------------------
-int SymmetricQuadTree::GetParentIndex(int index)
+int SymmetricQuadTree::GetParentIndex(int index) const
 {
 	return (index - 1) / 4;
 }
+
+//----------------------------------------------------------------------------------------------------
+// Adaptive quadtree
+//----------------------------------------------------------------------------------------------------
+constexpr int   ADAPTIVE_QT_MAX_DEPTH             = 16;    // Traversal stack holds 3 siblings per level plus the root
+constexpr float ADAPTIVE_QT_MAX_SPLIT_DUPLICATION = 2.f;   // Regular build: max child entries per convex for a split
+
+//----------------------------------------------------------------------------------------------------
+struct AdaptiveQTBuildSettings
+{
+	int  m_maxObjectsPerCell = 8;
+	int  m_maxDepth          = 8;
+	bool m_isLoose           = false;
+};
+
+//----------------------------------------------------------------------------------------------------
+static AABB2 GetLooseBounds_QT(AABB2 const& cellBounds)
+{
+	Vec2 halfDim = cellBounds.GetDimensions() * 0.5f;
+	return AABB2(cellBounds.m_mins - halfDim, cellBounds.m_maxs + halfDim);
+}
+
+//----------------------------------------------------------------------------------------------------
+static bool IsAABB2InsideAABB2_QT(AABB2 const& inner, AABB2 const& outer)
+{
+	return inner.m_mins.x >= outer.m_mins.x && inner.m_mins.y >= outer.m_mins.y &&
+	       inner.m_maxs.x <= outer.m_maxs.x && inner.m_maxs.y <= outer.m_maxs.y;
+}
+
+//----------------------------------------------------------------------------------------------------
+// 0=LB, 1=RB, 2=LT, 3=RT, same order as SymmetricQuadTree
+//----------------------------------------------------------------------------------------------------
+static AABB2 GetQuadrantBounds_QT(AABB2 const& cellBounds, int quadrant)
+{
+	Vec2 center = cellBounds.GetCenter();
+	switch (quadrant)
+	{
+	case 0:  return AABB2(cellBounds.m_mins, center);
+	case 1:  return AABB2(Vec2(center.x, cellBounds.m_mins.y), Vec2(cellBounds.m_maxs.x, center.y));
+	case 2:  return AABB2(Vec2(cellBounds.m_mins.x, center.y), Vec2(center.x, cellBounds.m_maxs.y));
+	default: return AABB2(center, cellBounds.m_maxs);
+	}
+}
+
+//----------------------------------------------------------------------------------------------------
+// Fills nodes[nodeIndex] for the convexes routed to cellBounds. A node's own convexes are appended to
+// primitives before its children are built, so every node's range stays contiguous.
+//----------------------------------------------------------------------------------------------------
+static void BuildAdaptiveQTNode(std::vector<AdaptiveQuadTreeNode>& nodes, std::vector<Convex2*>& primitives, std::vector<Convex2*> const& convexes,
+                                AABB2 const& cellBounds, int nodeIndex, int depth, AdaptiveQTBuildSettings const& settings)
+{
+	nodes[nodeIndex].m_bounds = settings.m_isLoose ? GetLooseBounds_QT(cellBounds) : cellBounds;
+
+	std::vector<Convex2*> kept;
+	std::vector<Convex2*> childConvexes[4];
+	bool canSplit = static_cast<int>(convexes.size()) > settings.m_maxObjectsPerCell && depth + 1 < settings.m_maxDepth;
+
+	if (canSplit && settings.m_isLoose)
+	{
+		// Route by box center; a convex too big for the child's loose bounds stays here
+		Vec2 center = cellBounds.GetCenter();
+		for (Convex2* convex : convexes)
+		{
+			Vec2 boxCenter = convex->m_boundingAABB.GetCenter();
+			int  quadrant  = ((boxCenter.x >= center.x) ? 1 : 0) + ((boxCenter.y >= center.y) ? 2 : 0);
+			if (IsAABB2InsideAABB2_QT(convex->m_boundingAABB, GetLooseBounds_QT(GetQuadrantBounds_QT(cellBounds, quadrant))))
+			{
+				childConvexes[quadrant].push_back(convex);
+			}
+			else
+			{
+				kept.push_back(convex);
+			}
+		}
+		canSplit = (kept.size() < convexes.size());
+	}
+	else if (canSplit)
+	{
+		size_t numChildEntries = 0;
+		for (int quadrant = 0; quadrant < 4; ++quadrant)
+		{
+			AABB2 childBounds = GetQuadrantBounds_QT(cellBounds, quadrant);
+			for (Convex2* convex : convexes)
+			{
+				if (DoAABB2sOverlap2D(convex->m_boundingAABB, childBounds))
+				{
+					childConvexes[quadrant].push_back(convex);
+				}
+			}
+			numChildEntries += childConvexes[quadrant].size();
+		}
+
+		// Once cells shrink to the size of the convexes most of them straddle the split and every level
+		// only multiplies the copies, so stop there
+		canSplit = (static_cast<float>(numChildEntries) <= ADAPTIVE_QT_MAX_SPLIT_DUPLICATION * static_cast<float>(convexes.size()));
+	}
+
+	std::vector<Convex2*> const& ownConvexes = canSplit ? kept : convexes;
+	nodes[nodeIndex].m_firstPrim = static_cast<int>(primitives.size());
+	nodes[nodeIndex].m_numPrims  = static_cast<int>(ownConvexes.size());
+	primitives.insert(primitives.end(), ownConvexes.begin(), ownConvexes.end());
+
+	if (!canSplit)
+	{
+		return;
+	}
+
+	int firstChild = static_cast<int>(nodes.size());
+	nodes[nodeIndex].m_firstChild = firstChild;
+	nodes.resize(nodes.size() + 4);
+	for (int quadrant = 0; quadrant < 4; ++quadrant)
+	{
+		BuildAdaptiveQTNode(nodes, primitives, childConvexes[quadrant], GetQuadrantBounds_QT(cellBounds, quadrant), firstChild + quadrant, depth + 1, settings);
+	}
+}
+
+//----------------------------------------------------------------------------------------------------
+void AdaptiveQuadTree::BuildTree(std::vector<Convex2*> const& convexArray, AABB2 const& totalBounds, bool isLoose, int maxObjectsPerCell, int maxDepth)
+{
+	m_nodes.clear();
+	m_primitives.clear();
+	m_isLoose = isLoose;
+
+	AdaptiveQTBuildSettings settings;
+	settings.m_maxObjectsPerCell = (maxObjectsPerCell < 1) ? 1 : maxObjectsPerCell;
+	settings.m_maxDepth          = std::clamp(maxDepth, 1, ADAPTIVE_QT_MAX_DEPTH);
+	settings.m_isLoose           = isLoose;
+
+	// Grow the root to cover convexes dragged outside the world so none is dropped
+	AABB2 rootBounds = totalBounds;
+	for (Convex2 const* convex : convexArray)
+	{
+		AABB2 const& box = convex->m_boundingAABB;
+		if (box.m_mins.x < rootBounds.m_mins.x) rootBounds.m_mins.x = box.m_mins.x;
+		if (box.m_mins.y < rootBounds.m_mins.y) rootBounds.m_mins.y = box.m_mins.y;
+		if (box.m_maxs.x > rootBounds.m_maxs.x) rootBounds.m_maxs.x = box.m_maxs.x;
+		if (box.m_maxs.y > rootBounds.m_maxs.y) rootBounds.m_maxs.y = box.m_maxs.y;
+	}
+
+	m_primitives.reserve(convexArray.size());
+	m_nodes.resize(1);
+	BuildAdaptiveQTNode(m_nodes, m_primitives, convexArray, rootBounds, 0, 0, settings);
+	m_nodes.shrink_to_fit();
+}
+
+//----------------------------------------------------------------------------------------------------
+void AdaptiveQuadTree::SolveRayResult(Vec2 const& startPos, Vec2 const& forwardVec, float maxDist, std::vector<Convex2*>& out_latentRes) const
+{
+	constexpr int MAX_STACK_SIZE = ADAPTIVE_QT_MAX_DEPTH * 3 + 1;
+
+	if (m_nodes.empty())
+	{
+		return;
+	}
+
+	size_t const    firstNewIndex = out_latentRes.size();
+	RaySlab2D const ray(startPos, forwardVec, maxDist);
+
+	int stack[MAX_STACK_SIZE];
+	int stackSize      = 0;
+	stack[stackSize++] = 0;
+
+	while (stackSize > 0)
+	{
+		AdaptiveQuadTreeNode const& node = m_nodes[stack[--stackSize]];
+		if (node.m_firstChild < 0 && node.m_numPrims == 0)
+		{
+			continue;
+		}
+		if (!ray.HitsAABB2(node.m_bounds))
+		{
+			continue;
+		}
+
+		Convex2* const* prims = m_primitives.data() + node.m_firstPrim;
+		out_latentRes.insert(out_latentRes.end(), prims, prims + node.m_numPrims);
+
+		if (node.m_firstChild >= 0)
+		{
+			stack[stackSize++] = node.m_firstChild + 3;
+			stack[stackSize++] = node.m_firstChild + 2;
+			stack[stackSize++] = node.m_firstChild + 1;
+			stack[stackSize++] = node.m_firstChild;
+		}
+	}
+
+	if (!m_isLoose)
+	{
+		RemoveDuplicates_QT(out_latentRes, firstNewIndex);
+	}
+}
+
+//----------------------------------------------------------------------------------------------------
+size_t AdaptiveQuadTree::GetMemoryFootprintBytes() const
+{
+	return m_nodes.capacity() * sizeof(AdaptiveQuadTreeNode) + m_primitives.capacity() * sizeof(Convex2*);
+}
@@ -11,8 +11,15 @@
 
 //----------------------------------------------------------------------------------------------------
 struct Convex2;
+struct RaycastResult2D;
 struct Vec2;
 
+//----------------------------------------------------------------------------------------------------
+// Most levels (root included) a SymmetricQuadTree may have. Traversal stacks are sized from it, so no query
+// can run out of stack and skip a cell.
+//----------------------------------------------------------------------------------------------------
+constexpr int MAX_SYMMETRIC_QUAD_TREE_LEVELS = 10;
+
 //----------------------------------------------------------------------------------------------------
 struct SymmetricQuadTreeNode
 {
@@ -25,14 +32,73 @@ class SymmetricQuadTree
 {
 public:
 	void BuildTree(std::vector<Convex2*> const& convexArray, int numOfRecursive, AABB2 const& totalBounds);
-	void SolveRayResult(Vec2 const& startPos, Vec2 const& forwardVec, float maxDist, std::vector<Convex2*> const& convexArray, std::vector<Convex2*>& out_latentRes);
+
+	// Appends every convex in the leaf cells the ray crosses, each once. Touches no shared state (dedup
+	// uses a per-thread table), so queries may run concurrently; cost follows the cells visited, not the scene size.
+	// out_numCellsVisited, when given, receives the number of leaf cells the ray crossed.
+	void SolveRayResult(Vec2 const& startPos, Vec2 const& forwardVec, float maxDist, std::vector<Convex2*>& out_latentRes, int* out_numCellsVisited = nullptr) const;
+
+	// Visits the children of each cell in ray entry order and raycasts leaf contents on arrival, so the walk
+	// ends once the best hit is nearer than every cell still queued. Same contract as AABB2Tree::SolveRayClosestHit.
+	Convex2* SolveRayClosestHit(Vec2 const& startPos, Vec2 const& forwardVec, float maxDist, RaycastResult2D& out_closestHit, int* out_numCellsVisited = nullptr) const;
+
+	// Appends every convex whose hull contains point: descends to the one leaf cell holding the point,
+	// then runs the exact IsPointInside test on that cell's list only.
+	void SolvePointResult(Vec2 const& point, std::vector<Convex2*>& out_containing) const;
+
+	// Batched SolvePointResult with the same CSR output as AABB2Tree::SolvePointBatch
+	void SolvePointBatch(Vec2 const* points, int numPoints, std::vector<int>& out_firstContaining, std::vector<Convex2*>& out_containing) const;
+
+	// Incremental update after convex moved from oldBounds to its current m_boundingAABB: only the leaf
+	// cells it left or entered are touched. Cells are fixed, so the tree never needs a quality rebuild.
+	void UpdateConvex(Convex2* convex, AABB2 const& oldBounds);
 
 	std::vector<SymmetricQuadTreeNode> m_nodes;
 
 protected:
-	int GetFirstLBChild(int index);
-	int GetSecondRBChild(int index);
-	int GetThirdLTChild(int index);
-	int GetForthRTChild(int index);
-	int GetParentIndex(int index);
+	int GetFirstLBChild(int index) const;
+	int GetSecondRBChild(int index) const;
+	int GetThirdLTChild(int index) const;
+	int GetForthRTChild(int index) const;
+	int GetParentIndex(int index) const;
+};
+
+//----------------------------------------------------------------------------------------------------
+// AdaptiveQuadTreeNode - No per-node allocations. The four children of a node are stored next to each other starting at
+// m_firstChild; the node's own convexes are AdaptiveQuadTree::m_primitives[m_firstPrim, +m_numPrims).
+//----------------------------------------------------------------------------------------------------
+struct AdaptiveQuadTreeNode
+{
+	AABB2 m_bounds;                 // Cell, or the loose cell (twice the size, same center) when built loose
+	int   m_firstChild = -1;        // -1 marks a leaf; LB, RB, LT, RT follow
+	int   m_firstPrim  = 0;
+	int   m_numPrims   = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// AdaptiveQuadTree - Splits a cell only while it holds more than maxObjectsPerCell convexes and is above
+// maxDepth, so empty regions stay one node and dense regions go deep.
+//
+// Regular: only leaves hold convexes and a convex is listed in every leaf it overlaps (queries dedup).
+// Loose:   every node's bounds are its cell grown by half a cell on each side, and each convex lives in
+//          exactly one node - the deepest whose loose bounds contain it - so queries never see duplicates.
+//----------------------------------------------------------------------------------------------------
+class AdaptiveQuadTree
+{
+public:
+	void BuildTree(std::vector<Convex2*> const& convexArray, AABB2 const& totalBounds, bool isLoose = false, int maxObjectsPerCell = 8, int maxDepth = 8);
+
+	// Appends every convex stored in a node the ray crosses, each once. Same contract as SymmetricQuadTree.
+	void SolveRayResult(Vec2 const& startPos, Vec2 const& forwardVec, float maxDist, std::vector<Convex2*>& out_latentRes) const;
+
+	// Heap bytes held by m_nodes and m_primitives
+	size_t GetMemoryFootprintBytes() const;
+
+	bool IsLoose() const { return m_isLoose; }
+
+	std::vector<AdaptiveQuadTreeNode> m_nodes;
+	std::vector<Convex2*>             m_primitives;
+
+protected:
+	bool m_isLoose = false;
 };
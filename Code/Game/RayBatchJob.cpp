@@ -0,0 +1,94 @@
+//----------------------------------------------------------------------------------------------------
+// RayBatchJob.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/RayBatchJob.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+constexpr int MIN_RAYS_PER_CHUNK = 1024;
+constexpr int CHUNKS_PER_WORKER  = 4;   // Oversubscribe so uneven chunks (dense regions) still balance
+
+//----------------------------------------------------------------------------------------------------
+RayBatchJob::RayBatchJob(eRayStrategy const strategy, RayBenchmarkScene const& scene, RayBatch const& rays, int const startIndex, int const endIndex)
+	: m_strategy(strategy)
+	, m_scene(scene)
+	, m_rays(rays)
+	, m_startIndex(startIndex)
+	, m_endIndex(endIndex)
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+void RayBatchJob::Execute()
+{
+	CastRayBatch(m_strategy, m_scene, m_rays, m_startIndex, m_endIndex, m_sumDist, m_numOfRayHit);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Sized from the generic workers the JobSystem actually started, not from the CPU count
+//----------------------------------------------------------------------------------------------------
+static int GetNumRayChunks(int const numRays)
+{
+	int numWorkers = g_jobSystem->GetGenericWorkerCount();
+	if (numWorkers < 1) numWorkers = 1;
+
+	int maxChunks = numRays / MIN_RAYS_PER_CHUNK;
+	if (maxChunks < 1) maxChunks = 1;
+
+	return std::min(numWorkers * CHUNKS_PER_WORKER, maxChunks);
+}
+
+//----------------------------------------------------------------------------------------------------
+void RunRayStrategyParallel(RayBenchmarkScene const& scene, RayBatch const& rays, RayStrategyResult& io_result)
+{
+	int const numRays      = rays.GetNumRays();
+	int const numChunks    = GetNumRayChunks(numRays);
+	int const raysPerChunk = (numRays + numChunks - 1) / numChunks;
+
+	auto startTime = std::chrono::steady_clock::now();
+
+	std::vector<RayBatchJob*> outstandingJobs;
+	outstandingJobs.reserve(numChunks);
+	for (int startIndex = 0; startIndex < numRays; startIndex += raysPerChunk)
+	{
+		int endIndex = std::min(startIndex + raysPerChunk, numRays);
+		outstandingJobs.push_back(new RayBatchJob(io_result.m_strategy, scene, rays, startIndex, endIndex));
+		g_jobSystem->SubmitJob(outstandingJobs.back());
+	}
+
+	// Only this batch's own jobs may be reduced; anything else completing here is a caller bug
+	float sumDist     = 0.f;
+	int   numOfRayHit = 0;
+	while (!outstandingJobs.empty())
+	{
+		Job* completedJob = g_jobSystem->RetrieveCompletedJob();
+		if (completedJob == nullptr)
+		{
+			std::this_thread::yield();
+			continue;
+		}
+
+		auto found = std::find(outstandingJobs.begin(), outstandingJobs.end(), completedJob);
+		GUARANTEE_OR_DIE(found != outstandingJobs.end(), "RunRayStrategyParallel retrieved a job it did not submit");
+
+		RayBatchJob* rayJob = *found;
+		sumDist     += rayJob->m_sumDist;
+		numOfRayHit += rayJob->m_numOfRayHit;
+		delete rayJob;
+		outstandingJobs.erase(found);
+	}
+
+	auto endTime = std::chrono::steady_clock::now();
+
+	io_result.m_parallelElapsedMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+	io_result.m_parallelMatchesSerial = (numOfRayHit == io_result.m_numOfRayHit);
+}
@@ -0,0 +1,35 @@
+//----------------------------------------------------------------------------------------------------
+// RayBatchJob.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include "Game/RayBenchmark.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/JobSystem.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// RayBatchJob - Casts one contiguous chunk [m_startIndex, m_endIndex) of a RayBatch on a worker thread
+// and keeps the chunk's partial sumDist / numOfRayHit for the main thread to reduce.
+//----------------------------------------------------------------------------------------------------
+class RayBatchJob : public Job
+{
+public:
+	RayBatchJob(eRayStrategy strategy, RayBenchmarkScene const& scene, RayBatch const& rays, int startIndex, int endIndex);
+
+	void Execute() override;
+
+	eRayStrategy             m_strategy;
+	RayBenchmarkScene const& m_scene;
+	RayBatch const&          m_rays;
+	int                      m_startIndex  = 0;
+	int                      m_endIndex    = 0;
+	float                    m_sumDist     = 0.f;
+	int                      m_numOfRayHit = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Splits rays into chunks, runs them on the JobSystem and blocks until every chunk is reduced.
+// Fills m_parallelElapsedMs of io_result and checks the reduced hit count against its serial run.
+//----------------------------------------------------------------------------------------------------
+void RunRayStrategyParallel(RayBenchmarkScene const& scene, RayBatch const& rays, RayStrategyResult& io_result);
@@ -0,0 +1,453 @@
+//----------------------------------------------------------------------------------------------------
+// RayBenchmark.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/RayBenchmark.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Game/BVH.hpp"
+#include "Game/Convex.hpp"
+#include "Game/ConvexSceneStore.hpp"
+#include "Game/QuadTree.hpp"
+#include "Game/RaySlab.hpp"
+#include "Game/UniformGrid.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Engine/Math/RaycastUtils.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+
+//----------------------------------------------------------------------------------------------------
+char const* GetRayStrategyName(eRayStrategy const strategy)
+{
+	switch (strategy)
+	{
+	case eRayStrategy::BRUTE_FORCE:                     return "NoOpt";
+	case eRayStrategy::DISC_REJECTION:                  return "Disc";
+	case eRayStrategy::AABB_REJECTION:                  return "AABB";
+	case eRayStrategy::SOA_BRUTE_FORCE:                 return "NoOpt-SoA";
+	case eRayStrategy::SOA_DISC_REJECTION:              return "Disc-SoA";
+	case eRayStrategy::SOA_AABB_REJECTION:              return "AABB-SoA";
+	case eRayStrategy::SOA_DISC_SWEEP:                  return "Disc-Sweep";
+	case eRayStrategy::SOA_AABB_SWEEP:                  return "AABB-Sweep";
+	case eRayStrategy::SYMMETRIC_QUAD_TREE:             return "QuadTree";
+	case eRayStrategy::SYMMETRIC_QUAD_TREE_CLOSEST_HIT: return "QuadTree-Closest";
+	case eRayStrategy::ADAPTIVE_QUAD_TREE:              return "AdaptiveQT";
+	case eRayStrategy::LOOSE_QUAD_TREE:                 return "LooseQT";
+	case eRayStrategy::AABB2_TREE:                      return "BVH";
+	case eRayStrategy::AABB2_TREE_CLOSEST_HIT:          return "BVH-Closest";
+	case eRayStrategy::AABB2_TREE_SAH:                  return "SAH";
+	case eRayStrategy::AABB2_TREE_SAH_CLOSEST_HIT:      return "SAH-Closest";
+	case eRayStrategy::AABB2_TREE_SAH_PACKET:           return "SAH-Packet";
+	case eRayStrategy::AABB2_TREE4_SAH:                 return "SAH4";
+	case eRayStrategy::AABB2_TREE4_SAH_CLOSEST_HIT:     return "SAH4-Closest";
+	case eRayStrategy::UNIFORM_GRID_DDA:                return "Grid-DDA";
+	default:                                            return "Unknown";
+	}
+}
+
+//----------------------------------------------------------------------------------------------------
+double RayStrategyResult::GetNanosecondsPerRay(int const numRays) const
+{
+	if (numRays <= 0) return 0.0;
+	return m_elapsedMs * 1000000.0 / static_cast<double>(numRays);
+}
+
+//----------------------------------------------------------------------------------------------------
+double RayStrategyResult::GetRaysPerSecond(int const numRays) const
+{
+	if (m_elapsedMs <= 0.0) return 0.0;
+	return static_cast<double>(numRays) * 1000.0 / m_elapsedMs;
+}
+
+//----------------------------------------------------------------------------------------------------
+double RayStrategyResult::GetParallelSpeedup() const
+{
+	if (m_parallelElapsedMs <= 0.0) return 0.0;
+	return m_elapsedMs / m_parallelElapsedMs;
+}
+
+//----------------------------------------------------------------------------------------------------
+double RayStrategyResult::GetSpeedupOver(RayStrategyResult const& baseline) const
+{
+	if (m_elapsedMs <= 0.0) return 0.0;
+	return baseline.m_elapsedMs / m_elapsedMs;
+}
+
+//----------------------------------------------------------------------------------------------------
+void GenerateRandomRays(RayBatch& out_rays, int const numRays, AABB2 const& bounds, RandomNumberGenerator& rng)
+{
+	out_rays.m_startPos.resize(numRays);
+	out_rays.m_forwardNormal.resize(numRays);
+	out_rays.m_maxDist.resize(numRays);
+
+	for (int j = 0; j < numRays; ++j)
+	{
+		Vec2 p1(rng.RollRandomFloatInRange(bounds.m_mins.x, bounds.m_maxs.x),
+		        rng.RollRandomFloatInRange(bounds.m_mins.y, bounds.m_maxs.y));
+		Vec2 p2(rng.RollRandomFloatInRange(bounds.m_mins.x, bounds.m_maxs.x),
+		        rng.RollRandomFloatInRange(bounds.m_mins.y, bounds.m_maxs.y));
+		Vec2 disp = p2 - p1;
+		out_rays.m_startPos[j]      = p1;
+		out_rays.m_maxDist[j]       = disp.GetLength();
+		out_rays.m_forwardNormal[j] = disp.GetNormalized();
+	}
+}
+
+//----------------------------------------------------------------------------------------------------
+void GenerateRayFans(RayBatch& out_rays, int const numRays, int const raysPerFan, float const fanDegrees, AABB2 const& bounds, RandomNumberGenerator& rng)
+{
+	out_rays.m_startPos.resize(numRays);
+	out_rays.m_forwardNormal.resize(numRays);
+	out_rays.m_maxDist.resize(numRays);
+
+	int const   fanSize = (raysPerFan < 1) ? 1 : raysPerFan;
+	float const maxDist = bounds.GetDimensions().GetLength() * 0.5f;
+	float const stepDeg = (fanSize > 1) ? fanDegrees / static_cast<float>(fanSize - 1) : 0.f;
+
+	for (int first = 0; first < numRays; first += fanSize)
+	{
+		Vec2  startPos(rng.RollRandomFloatInRange(bounds.m_mins.x, bounds.m_maxs.x),
+		               rng.RollRandomFloatInRange(bounds.m_mins.y, bounds.m_maxs.y));
+		float firstDeg = rng.RollRandomFloatInRange(0.f, 360.f) - fanDegrees * 0.5f;
+
+		for (int j = first; j < first + fanSize && j < numRays; ++j)
+		{
+			out_rays.m_startPos[j]      = startPos;
+			out_rays.m_maxDist[j]       = maxDist;
+			out_rays.m_forwardNormal[j] = Vec2::MakeFromPolarDegrees(firstDeg + stepDeg * static_cast<float>(j - first));
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------
+template <eRayRejection REJECTION>
+static float CastRayVsCandidates(std::vector<Convex2*> const& candidates, RaySlab2D const& ray)
+{
+	RaycastResult2D rayRes;
+	float minDist = FLT_MAX;
+	for (Convex2* convex : candidates)
+	{
+		if (convex->RayCastVsConvex2D<REJECTION>(rayRes, ray))
+		{
+			if (rayRes.m_impactLength < minDist) minDist = rayRes.m_impactLength;
+		}
+	}
+	return minDist;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Returns the closest impact length along the ray, or FLT_MAX when nothing was hit
+//----------------------------------------------------------------------------------------------------
+static float CastRayForClosestDist(eRayStrategy const strategy, RayBenchmarkScene const& scene, Vec2 const& startPos, Vec2 const& forwardNormal, float const maxDist, std::vector<Convex2*>& scratchCandidates, std::vector<int>& scratchSurvivors)
+{
+	RaycastResult2D rayRes;
+
+	std::vector<Convex2*> const* candidates = scene.m_convexes;
+	eRayRejection                rejection  = eRayRejection::DISC;
+
+	switch (strategy)
+	{
+	case eRayStrategy::BRUTE_FORCE:
+	{
+		// The Engine's hull routine rather than RaycastVsPlanes2D, so the baseline is an independent implementation
+		float minDist = FLT_MAX;
+		for (Convex2 const* convex : *scene.m_convexes)
+		{
+			rayRes = RaycastVsConvexHull2D(startPos, forwardNormal, maxDist, convex->m_convexHull);
+			if (rayRes.m_didImpact && rayRes.m_impactLength < minDist) minDist = rayRes.m_impactLength;
+		}
+		return minDist;
+	}
+	case eRayStrategy::DISC_REJECTION:
+		break;
+	case eRayStrategy::AABB_REJECTION:
+		rejection = eRayRejection::AABB;
+		break;
+	case eRayStrategy::SOA_BRUTE_FORCE:
+	case eRayStrategy::SOA_DISC_REJECTION:
+	case eRayStrategy::SOA_AABB_REJECTION:
+		if (scene.m_convexStore->RaycastClosest(startPos, forwardNormal, maxDist, strategy == eRayStrategy::SOA_DISC_REJECTION,
+		                                        strategy == eRayStrategy::SOA_AABB_REJECTION, rayRes) >= 0)
+		{
+			return rayRes.m_impactLength;
+		}
+		return FLT_MAX;
+	case eRayStrategy::SOA_DISC_SWEEP:
+	case eRayStrategy::SOA_AABB_SWEEP:
+		if (scene.m_convexStore->RaycastClosestSwept(startPos, forwardNormal, maxDist, strategy == eRayStrategy::SOA_DISC_SWEEP, scratchSurvivors, rayRes) >= 0)
+		{
+			return rayRes.m_impactLength;
+		}
+		return FLT_MAX;
+	case eRayStrategy::SYMMETRIC_QUAD_TREE:
+		scratchCandidates.clear();
+		scene.m_symQuadTree->SolveRayResult(startPos, forwardNormal, maxDist, scratchCandidates);
+		candidates = &scratchCandidates;
+		break;
+	case eRayStrategy::SYMMETRIC_QUAD_TREE_CLOSEST_HIT:
+		if (scene.m_symQuadTree->SolveRayClosestHit(startPos, forwardNormal, maxDist, rayRes) != nullptr)
+		{
+			return rayRes.m_impactLength;
+		}
+		return FLT_MAX;
+	case eRayStrategy::ADAPTIVE_QUAD_TREE:
+		scratchCandidates.clear();
+		scene.m_adaptiveQuadTree->SolveRayResult(startPos, forwardNormal, maxDist, scratchCandidates);
+		candidates = &scratchCandidates;
+		break;
+	case eRayStrategy::LOOSE_QUAD_TREE:
+		scratchCandidates.clear();
+		scene.m_looseQuadTree->SolveRayResult(startPos, forwardNormal, maxDist, scratchCandidates);
+		candidates = &scratchCandidates;
+		break;
+	case eRayStrategy::AABB2_TREE:
+		scratchCandidates.clear();
+		scene.m_AABB2Tree->SolveRayResult(startPos, forwardNormal, maxDist, scratchCandidates);
+		candidates = &scratchCandidates;
+		break;
+	case eRayStrategy::AABB2_TREE_CLOSEST_HIT:
+		if (scene.m_AABB2Tree->SolveRayClosestHit(startPos, forwardNormal, maxDist, rayRes) != nullptr)
+		{
+			return rayRes.m_impactLength;
+		}
+		return FLT_MAX;
+	case eRayStrategy::AABB2_TREE_SAH:
+		scratchCandidates.clear();
+		scene.m_AABB2TreeSAH->SolveRayResult(startPos, forwardNormal, maxDist, scratchCandidates);
+		candidates = &scratchCandidates;
+		break;
+	case eRayStrategy::AABB2_TREE_SAH_CLOSEST_HIT:
+		if (scene.m_AABB2TreeSAH->SolveRayClosestHit(startPos, forwardNormal, maxDist, rayRes) != nullptr)
+		{
+			return rayRes.m_impactLength;
+		}
+		return FLT_MAX;
+	case eRayStrategy::AABB2_TREE4_SAH:
+		scratchCandidates.clear();
+		scene.m_AABB2Tree4SAH->SolveRayResult(startPos, forwardNormal, maxDist, scratchCandidates);
+		candidates = &scratchCandidates;
+		break;
+	case eRayStrategy::AABB2_TREE4_SAH_CLOSEST_HIT:
+		if (scene.m_AABB2Tree4SAH->SolveRayClosestHit(startPos, forwardNormal, maxDist, rayRes) != nullptr)
+		{
+			return rayRes.m_impactLength;
+		}
+		return FLT_MAX;
+	case eRayStrategy::UNIFORM_GRID_DDA:
+		if (scene.m_uniformGrid->SolveRayClosestHit(startPos, forwardNormal, maxDist, rayRes) != nullptr)
+		{
+			return rayRes.m_impactLength;
+		}
+		return FLT_MAX;
+	default:
+		return FLT_MAX;
+	}
+
+	// One branch on the rejection mode per ray instead of one per convex
+	RaySlab2D const ray(startPos, forwardNormal, maxDist);
+	switch (rejection)
+	{
+	case eRayRejection::AABB: return CastRayVsCandidates<eRayRejection::AABB>(*candidates, ray);
+	default:                  return CastRayVsCandidates<eRayRejection::DISC>(*candidates, ray);
+	}
+}
+
+//----------------------------------------------------------------------------------------------------
+// Consecutive rays go into one packet, so a coherent batch (GenerateRayFans) gives coherent packets
+//----------------------------------------------------------------------------------------------------
+static void CastRayPackets(RayBenchmarkScene const& scene, RayBatch const& rays, int const startIndex, int const endIndex, float& out_sumDist, int& out_numOfRayHit)
+{
+	int const packetSize = std::clamp(scene.m_rayPacketSize, 1, MAX_RAY_PACKET_SIZE);
+
+	RaycastResult2D closestHits[MAX_RAY_PACKET_SIZE];
+	Convex2*        closestConvexes[MAX_RAY_PACKET_SIZE];
+	float sumDist     = 0.f;
+	int   numOfRayHit = 0;
+
+	for (int first = startIndex; first < endIndex; first += packetSize)
+	{
+		RayPacket2D packet;
+		for (int j = first; j < first + packetSize && j < endIndex; ++j)
+		{
+			packet.AddRay(rays.m_startPos[j], rays.m_forwardNormal[j], rays.m_maxDist[j]);
+		}
+		packet.Prepare();
+
+		scene.m_AABB2TreeSAH->SolveRayPacketClosestHit(packet, closestHits, closestConvexes);
+		for (int lane = 0; lane < packet.m_numRays; ++lane)
+		{
+			if (closestConvexes[lane] != nullptr) { sumDist += closestHits[lane].m_impactLength; ++numOfRayHit; }
+		}
+	}
+
+	out_sumDist     = sumDist;
+	out_numOfRayHit = numOfRayHit;
+}
+
+//----------------------------------------------------------------------------------------------------
+void CastRayBatch(eRayStrategy const strategy, RayBenchmarkScene const& scene, RayBatch const& rays, int const startIndex, int const endIndex, float& out_sumDist, int& out_numOfRayHit)
+{
+	if (strategy == eRayStrategy::AABB2_TREE_SAH_PACKET)
+	{
+		CastRayPackets(scene, rays, startIndex, endIndex, out_sumDist, out_numOfRayHit);
+		return;
+	}
+
+	std::vector<Convex2*> scratchCandidates;
+	std::vector<int>      scratchSurvivors;
+	float sumDist     = 0.f;
+	int   numOfRayHit = 0;
+
+	for (int j = startIndex; j < endIndex; ++j)
+	{
+		float minDist = CastRayForClosestDist(strategy, scene, rays.m_startPos[j], rays.m_forwardNormal[j], rays.m_maxDist[j], scratchCandidates, scratchSurvivors);
+		if (minDist != FLT_MAX) { sumDist += minDist; ++numOfRayHit; }
+	}
+
+	out_sumDist     = sumDist;
+	out_numOfRayHit = numOfRayHit;
+}
+
+//----------------------------------------------------------------------------------------------------
+void MeasureQuadTreeCellsPerRay(SymmetricQuadTree const& tree, RayBatch const& rays, float& out_avgCellsCollect, float& out_avgCellsClosest)
+{
+	std::vector<Convex2*> scratchCandidates;
+	RaycastResult2D       rayRes;
+	int64_t               sumCellsCollect = 0;
+	int64_t               sumCellsClosest = 0;
+
+	for (int i = 0; i < rays.GetNumRays(); ++i)
+	{
+		int numCells = 0;
+		scratchCandidates.clear();
+		tree.SolveRayResult(rays.m_startPos[i], rays.m_forwardNormal[i], rays.m_maxDist[i], scratchCandidates, &numCells);
+		sumCellsCollect += numCells;
+		tree.SolveRayClosestHit(rays.m_startPos[i], rays.m_forwardNormal[i], rays.m_maxDist[i], rayRes, &numCells);
+		sumCellsClosest += numCells;
+	}
+
+	float const numRays = static_cast<float>(std::max(rays.GetNumRays(), 1));
+	out_avgCellsCollect = static_cast<float>(sumCellsCollect) / numRays;
+	out_avgCellsClosest = static_cast<float>(sumCellsClosest) / numRays;
+}
+
+//----------------------------------------------------------------------------------------------------
+// AABB2TreeNode as it was before the flat layout: every node owns a heap array of its convexes
+//----------------------------------------------------------------------------------------------------
+struct VectorAABB2TreeNode_RB
+{
+	AABB2                 m_bounds;
+	int                   m_leftChild  = -1;
+	int                   m_rightChild = -1;
+	std::vector<Convex2*> m_containingConvex;
+};
+
+//----------------------------------------------------------------------------------------------------
+bool MeasureAABB2TreeLayouts(AABB2Tree const& tree, RayBatch const& rays, double& out_flatMs, double& out_vectorNodeMs)
+{
+	std::vector<VectorAABB2TreeNode_RB> vectorNodes(tree.m_nodes.size());
+	for (int n = 0; n < static_cast<int>(tree.m_nodes.size()); ++n)
+	{
+		AABB2TreeNode const& node  = tree.m_nodes[n];
+		Convex2* const*      prims = tree.GetNodePrimitives(node);
+		vectorNodes[n].m_bounds           = node.m_bounds;
+		vectorNodes[n].m_leftChild        = node.m_leftChild;
+		vectorNodes[n].m_rightChild       = node.m_rightChild;
+		vectorNodes[n].m_containingConvex.assign(prims, prims + node.m_numPrims);
+	}
+
+	std::vector<Convex2*> scratchCandidates;
+	int stack[MAX_AABB2_TREE_DEPTH + 1];
+
+	// Same walk over either layout; collectLeaf appends a leaf's convexes
+	auto walk = [&](auto const& nodes, auto const& collectLeaf)
+	{
+		size_t numCandidates = 0;
+		for (int i = 0; i < rays.GetNumRays() && !nodes.empty(); ++i)
+		{
+			RaySlab2D const ray(rays.m_startPos[i], rays.m_forwardNormal[i], rays.m_maxDist[i]);
+			scratchCandidates.clear();
+			int stackSize      = 0;
+			stack[stackSize++] = 0;
+			while (stackSize > 0)
+			{
+				auto const& node = nodes[stack[--stackSize]];
+				if (!ray.HitsAABB2(node.m_bounds)) continue;
+				if (node.m_leftChild < 0)
+				{
+					collectLeaf(node);
+					continue;
+				}
+				GUARANTEE_OR_DIE(stackSize + 2 <= MAX_AABB2_TREE_DEPTH + 1, "AABB2Tree deeper than MAX_AABB2_TREE_DEPTH");
+				stack[stackSize++] = node.m_rightChild;
+				stack[stackSize++] = node.m_leftChild;
+			}
+			numCandidates += scratchCandidates.size();
+		}
+		return numCandidates;
+	};
+
+	auto collectFlat = [&](AABB2TreeNode const& node)
+	{
+		Convex2* const* prims = tree.GetNodePrimitives(node);
+		scratchCandidates.insert(scratchCandidates.end(), prims, prims + node.m_numPrims);
+	};
+	auto collectVector = [&](VectorAABB2TreeNode_RB const& node)
+	{
+		scratchCandidates.insert(scratchCandidates.end(), node.m_containingConvex.begin(), node.m_containingConvex.end());
+	};
+
+	// Alternate the layouts and keep the best of two runs each, so neither profits from running second
+	size_t flatCandidates   = 0;
+	size_t vectorCandidates = 0;
+	out_flatMs       = DBL_MAX;
+	out_vectorNodeMs = DBL_MAX;
+	for (int run = 0; run < 2; ++run)
+	{
+		auto startTime = std::chrono::steady_clock::now();
+		flatCandidates = walk(tree.m_nodes, collectFlat);
+		auto midTime = std::chrono::steady_clock::now();
+		vectorCandidates = walk(vectorNodes, collectVector);
+		auto endTime = std::chrono::steady_clock::now();
+
+		out_flatMs       = std::min(out_flatMs, std::chrono::duration<double, std::milli>(midTime - startTime).count());
+		out_vectorNodeMs = std::min(out_vectorNodeMs, std::chrono::duration<double, std::milli>(endTime - midTime).count());
+	}
+	return flatCandidates == vectorCandidates;
+}
+
+//----------------------------------------------------------------------------------------------------
+RayStrategyResult RunRayStrategy(eRayStrategy const strategy, RayBenchmarkScene const& scene, RayBatch const& rays)
+{
+	RayStrategyResult result;
+	result.m_strategy = strategy;
+
+	auto startTime = std::chrono::steady_clock::now();
+	CastRayBatch(strategy, scene, rays, 0, rays.GetNumRays(), result.m_sumDist, result.m_numOfRayHit);
+	auto endTime = std::chrono::steady_clock::now();
+
+	result.m_elapsedMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+	return result;
+}
+
+//----------------------------------------------------------------------------------------------------
+std::vector<RayStrategyResult> RunAllRayStrategies(RayBenchmarkScene const& scene, RayBatch const& rays)
+{
+	std::vector<RayStrategyResult> results;
+	results.reserve(NUM_RAY_STRATEGIES);
+
+	for (int s = 0; s < NUM_RAY_STRATEGIES; ++s)
+	{
+		RayStrategyResult result = RunRayStrategy(static_cast<eRayStrategy>(s), scene, rays);
+		if (!results.empty())
+		{
+			result.m_matchesBaseline = (result.m_numOfRayHit == results[0].m_numOfRayHit);
+		}
+		results.push_back(result);
+	}
+	return results;
+}
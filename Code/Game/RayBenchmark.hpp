@@ -0,0 +1,124 @@
+//----------------------------------------------------------------------------------------------------
+// RayBenchmark.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/Vec2.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <cstdint>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+class AABB2Tree;
+class AABB2Tree4;
+class AdaptiveQuadTree;
+class ConvexSceneStore;
+class RandomNumberGenerator;
+class SymmetricQuadTree;
+class UniformGrid2D;
+struct Convex2;
+
+//----------------------------------------------------------------------------------------------------
+// Ray strategies compared by GameConvexScene::TestRays and the headless RayBenchmark tool.
+// BRUTE_FORCE is the baseline every other strategy must agree with.
+//----------------------------------------------------------------------------------------------------
+enum class eRayStrategy : uint8_t
+{
+	BRUTE_FORCE,
+	DISC_REJECTION,
+	AABB_REJECTION,
+	SOA_BRUTE_FORCE,
+	SOA_DISC_REJECTION,
+	SOA_AABB_REJECTION,
+	SOA_DISC_SWEEP,
+	SOA_AABB_SWEEP,
+	SYMMETRIC_QUAD_TREE,
+	SYMMETRIC_QUAD_TREE_CLOSEST_HIT,
+	ADAPTIVE_QUAD_TREE,
+	LOOSE_QUAD_TREE,
+	AABB2_TREE,
+	AABB2_TREE_CLOSEST_HIT,
+	AABB2_TREE_SAH,
+	AABB2_TREE_SAH_CLOSEST_HIT,
+	AABB2_TREE_SAH_PACKET,
+	AABB2_TREE4_SAH,
+	AABB2_TREE4_SAH_CLOSEST_HIT,
+	UNIFORM_GRID_DDA,
+	COUNT
+};
+
+constexpr int NUM_RAY_STRATEGIES = static_cast<int>(eRayStrategy::COUNT);
+
+char const* GetRayStrategyName(eRayStrategy strategy);
+
+//----------------------------------------------------------------------------------------------------
+// RayBatch - Random rays stored as parallel arrays (start, unit forward, max length)
+//----------------------------------------------------------------------------------------------------
+struct RayBatch
+{
+	std::vector<Vec2>  m_startPos;
+	std::vector<Vec2>  m_forwardNormal;
+	std::vector<float> m_maxDist;
+
+	int GetNumRays() const { return static_cast<int>(m_startPos.size()); }
+};
+
+//----------------------------------------------------------------------------------------------------
+// RayBenchmarkScene - Non-owning view of everything a strategy needs to cast rays
+//----------------------------------------------------------------------------------------------------
+struct RayBenchmarkScene
+{
+	std::vector<Convex2*> const* m_convexes         = nullptr;
+	ConvexSceneStore const*      m_convexStore      = nullptr;  // SoA copy of m_convexes for the SOA_ strategies
+	SymmetricQuadTree const*     m_symQuadTree      = nullptr;
+	AdaptiveQuadTree const*      m_adaptiveQuadTree = nullptr;  // Regular build
+	AdaptiveQuadTree const*      m_looseQuadTree    = nullptr;  // Loose build
+	AABB2Tree const*             m_AABB2Tree        = nullptr;  // Midpoint build
+	AABB2Tree const*             m_AABB2TreeSAH     = nullptr;  // SAH build
+	AABB2Tree4 const*            m_AABB2Tree4SAH    = nullptr;  // BVH4 collapsed from the SAH build
+	UniformGrid2D const*         m_uniformGrid      = nullptr;
+	int                          m_rayPacketSize    = 16;       // Rays per packet for AABB2_TREE_SAH_PACKET (1..16)
+};
+
+//----------------------------------------------------------------------------------------------------
+struct RayStrategyResult
+{
+	eRayStrategy m_strategy        = eRayStrategy::BRUTE_FORCE;
+	double       m_elapsedMs       = 0.0;
+	float        m_sumDist         = 0.f;
+	int          m_numOfRayHit     = 0;
+	bool         m_matchesBaseline = true;
+
+	// Filled only when the batch was also run chunked on the JobSystem (0 = not run)
+	double       m_parallelElapsedMs     = 0.0;
+	bool         m_parallelMatchesSerial = true;
+
+	double GetNanosecondsPerRay(int numRays) const;
+	double GetRaysPerSecond(int numRays) const;
+	double GetParallelSpeedup() const;
+	double GetSpeedupOver(RayStrategyResult const& baseline) const;
+};
+
+//----------------------------------------------------------------------------------------------------
+void GenerateRandomRays(RayBatch& out_rays, int numRays, AABB2 const& bounds, RandomNumberGenerator& rng);
+
+// Coherent batch: consecutive groups of raysPerFan rays share a random start and spread evenly over
+// fanDegrees around a random direction, like a light or sensor sweep
+void GenerateRayFans(RayBatch& out_rays, int numRays, int raysPerFan, float fanDegrees, AABB2 const& bounds, RandomNumberGenerator& rng);
+
+// Casts rays [startIndex, endIndex) and accumulates the closest-hit distance of every ray that hits
+void CastRayBatch(eRayStrategy strategy, RayBenchmarkScene const& scene, RayBatch const& rays, int startIndex, int endIndex, float& out_sumDist, int& out_numOfRayHit);
+
+// Mean leaf cells per ray the SymmetricQuadTree visits when collecting every candidate (SYMMETRIC_QUAD_TREE)
+// and when walking front to back to the closest hit (SYMMETRIC_QUAD_TREE_CLOSEST_HIT)
+void MeasureQuadTreeCellsPerRay(SymmetricQuadTree const& tree, RayBatch const& rays, float& out_avgCellsCollect, float& out_avgCellsClosest);
+
+// Times candidate collection on tree's flat layout (32-byte nodes over one primitive array) and on a copy in
+// the layout it replaced (a std::vector<Convex2*> per node). Both walks are the same stack traversal, so the
+// ratio isolates node layout. Returns false when the two layouts collect different candidates.
+bool MeasureAABB2TreeLayouts(AABB2Tree const& tree, RayBatch const& rays, double& out_flatMs, double& out_vectorNodeMs);
+
+RayStrategyResult              RunRayStrategy(eRayStrategy strategy, RayBenchmarkScene const& scene, RayBatch const& rays);
+std::vector<RayStrategyResult> RunAllRayStrategies(RayBenchmarkScene const& scene, RayBatch const& rays);
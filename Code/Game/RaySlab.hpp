@@ -0,0 +1,120 @@
+//----------------------------------------------------------------------------------------------------
+// RaySlab.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/Vec2.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RAY_SLAB_SSE2
+#include <emmintrin.h>
+#endif
+
+//----------------------------------------------------------------------------------------------------
+// RaySlab2D - Ray prepared once, then shared by every box, disc and convex test along its traversal.
+//
+// RaycastVsAABB2D also builds the impact position and normal; traversal only needs "hit" and the entry
+// distance, so this keeps 1/forward per axis and does two multiplies per slab. Axis-parallel rays get
+// a huge finite reciprocal instead of infinity so a start exactly on a slab plane never produces NaN.
+// Touching counts as a hit, so results are a superset of RaycastVsAABB2D.
+//----------------------------------------------------------------------------------------------------
+struct RaySlab2D
+{
+	RaySlab2D() = default;
+	RaySlab2D(Vec2 const& startPos, Vec2 const& forwardVec, float maxDist)
+		: m_startPos(startPos)
+		, m_forwardVec(forwardVec)
+		, m_invForward(GetSafeReciprocal(forwardVec.x), GetSafeReciprocal(forwardVec.y))
+		, m_maxDist(maxDist)
+	{
+	}
+
+	// Entry distance is clamped to 0 when the ray starts inside bounds
+	bool HitsAABB2(AABB2 const& bounds, float& out_entryDist) const
+	{
+		float tx1 = (bounds.m_mins.x - m_startPos.x) * m_invForward.x;
+		float tx2 = (bounds.m_maxs.x - m_startPos.x) * m_invForward.x;
+		float ty1 = (bounds.m_mins.y - m_startPos.y) * m_invForward.y;
+		float ty2 = (bounds.m_maxs.y - m_startPos.y) * m_invForward.y;
+
+		float tEnter = Max(Max(Min(tx1, tx2), Min(ty1, ty2)), 0.f);
+		float tExit  = Min(Min(Max(tx1, tx2), Max(ty1, ty2)), m_maxDist);
+		out_entryDist = tEnter;
+		return tEnter <= tExit;
+	}
+
+	bool HitsAABB2(AABB2 const& bounds) const
+	{
+		float entryDist;
+		return HitsAABB2(bounds, entryDist);
+	}
+
+	// Closest point of the ray segment to center against radius; touching counts, like HitsAABB2
+	bool HitsDisc2(Vec2 const& center, float radius) const
+	{
+		float const toCenterX = center.x - m_startPos.x;
+		float const toCenterY = center.y - m_startPos.y;
+		float const along     = Min(Max(toCenterX * m_forwardVec.x + toCenterY * m_forwardVec.y, 0.f), m_maxDist);
+
+		float const offsetX = toCenterX - m_forwardVec.x * along;
+		float const offsetY = toCenterY - m_forwardVec.y * along;
+		return offsetX * offsetX + offsetY * offsetY <= radius * radius;
+	}
+
+	// Tests four boxes given as SoA lanes; returns a bit per hit lane (bit i = lane i). An empty lane
+	// (mins > maxs) never hits.
+	int HitsAABB2x4(float const* minX, float const* minY, float const* maxX, float const* maxY, float* out_entryDist) const
+	{
+#if defined(RAY_SLAB_SSE2)
+		__m128 startX = _mm_set1_ps(m_startPos.x);
+		__m128 startY = _mm_set1_ps(m_startPos.y);
+		__m128 invX   = _mm_set1_ps(m_invForward.x);
+		__m128 invY   = _mm_set1_ps(m_invForward.y);
+
+		__m128 tx1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(minX), startX), invX);
+		__m128 tx2 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(maxX), startX), invX);
+		__m128 ty1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(minY), startY), invY);
+		__m128 ty2 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(maxY), startY), invY);
+
+		__m128 tEnter = _mm_max_ps(_mm_max_ps(_mm_min_ps(tx1, tx2), _mm_min_ps(ty1, ty2)), _mm_setzero_ps());
+		__m128 tExit  = _mm_min_ps(_mm_min_ps(_mm_max_ps(tx1, tx2), _mm_max_ps(ty1, ty2)), _mm_set1_ps(m_maxDist));
+
+		// An empty lane's inverted slabs can overflow into an infinite interval, so mask it out explicitly
+		__m128 isValid = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(minX), _mm_loadu_ps(maxX)), _mm_cmple_ps(_mm_loadu_ps(minY), _mm_loadu_ps(maxY)));
+		_mm_storeu_ps(out_entryDist, tEnter);
+		return _mm_movemask_ps(_mm_and_ps(_mm_cmple_ps(tEnter, tExit), isValid));
+#else
+		int hitMask = 0;
+		for (int lane = 0; lane < 4; ++lane)
+		{
+			if (minX[lane] > maxX[lane] || minY[lane] > maxY[lane]) continue;
+			if (HitsAABB2(AABB2(Vec2(minX[lane], minY[lane]), Vec2(maxX[lane], maxY[lane])), out_entryDist[lane]))
+			{
+				hitMask |= (1 << lane);
+			}
+		}
+		return hitMask;
+#endif
+	}
+
+	Vec2  m_startPos;
+	Vec2  m_forwardVec;
+	Vec2  m_invForward;
+	float m_maxDist = 0.f;     // Closest-hit traversals shrink this to the best impact so far
+
+private:
+	// Plain compares map to minss / maxss; fminf / fmaxf carry NaN rules that keep them out of line
+	static float Min(float a, float b) { return (a < b) ? a : b; }
+	static float Max(float a, float b) { return (a > b) ? a : b; }
+
+	static float GetSafeReciprocal(float value)
+	{
+		constexpr float HUGE_RECIPROCAL = 1e30f;
+		if (fabsf(value) < 1e-30f) return (value < 0.f) ? -HUGE_RECIPROCAL : HUGE_RECIPROCAL;
+		return 1.f / value;
+	}
+};
@@ -0,0 +1,373 @@
+//----------------------------------------------------------------------------------------------------
+// SceneChunkJob.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/SceneChunkJob.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Game/Convex.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/BufferParser.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/StringUtils.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+//----------------------------------------------------------------------------------------------------
+SceneChunkDecodeJob::SceneChunkDecodeJob(uint8_t const chunkType, uint8_t const chunkEndian, bool const wideIndices, unsigned char const* chunkData,
+                                         unsigned int const dataSize, std::vector<Convex2*> const& convexes, int const firstConvexIndex,
+                                         AABB2 const& sceneBounds)
+	: m_chunkType(chunkType)
+	, m_chunkEndian(chunkEndian)
+	, m_wideIndices(wideIndices)
+	, m_chunkData(chunkData)
+	, m_dataSize(dataSize)
+	, m_convexes(convexes)
+	, m_firstConvexIndex(firstConvexIndex)
+	, m_sceneBounds(sceneBounds)
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+// Object counts and object indices share one width per file
+//----------------------------------------------------------------------------------------------------
+static uint32_t ParseObjectIndex_SCJ(BufferParser& bufParse, bool const wideIndices)
+{
+	return wideIndices ? bufParse.ParseUint32() : static_cast<uint32_t>(bufParse.ParseUshort());
+}
+
+//----------------------------------------------------------------------------------------------------
+// True when count records of at least recordBytes each still fit in the chunk
+//----------------------------------------------------------------------------------------------------
+static bool DoRecordsFit_SCJ(BufferParser const& bufParse, size_t const dataSize, uint32_t const count, size_t const recordBytes)
+{
+	size_t const position = bufParse.GetCurrentPosition();
+	if (position > dataSize) return false;
+	return static_cast<uint64_t>(count) * recordBytes <= dataSize - position;
+}
+
+//----------------------------------------------------------------------------------------------------
+static void DecodeConvexPolys_SCJ(BufferParser& bufParse, bool const wideIndices, std::vector<Convex2*> const& convexes, int const firstConvexIndex)
+{
+	int numObjects = static_cast<int>(ParseObjectIndex_SCJ(bufParse, wideIndices));
+	std::vector<Vec2> verts;   // Reused, so only the first convexes grow it
+	for (int i = 0; i < numObjects && firstConvexIndex + i < static_cast<int>(convexes.size()); ++i)
+	{
+		uint8_t numVerts = bufParse.ParseByte();
+		verts.clear();
+		for (int j = 0; j < static_cast<int>(numVerts); ++j)
+		{
+			verts.push_back(bufParse.ParseVec2());
+		}
+		convexes[firstConvexIndex + i]->m_convexPoly = ConvexPoly2(verts);
+	}
+}
+
+//----------------------------------------------------------------------------------------------------
+// LEB128: 7 bits per byte, high bit set on every byte but the last
+//----------------------------------------------------------------------------------------------------
+static uint32_t ParseVarUint32_SCJ(BufferParser& bufParse)
+{
+	uint32_t value = 0;
+	for (int shift = 0; shift < 35; shift += 7)
+	{
+		uint8_t byte = bufParse.ParseByte();
+		value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+		if ((byte & 0x80) == 0) break;
+	}
+	return value;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Count is always uint32 here; the chunk postdates the 16-bit layouts
+//----------------------------------------------------------------------------------------------------
+static bool DecodeQuantizedConvexPolys_SCJ(BufferParser& bufParse, size_t const dataSize, std::vector<Convex2*> const& convexes, int const firstConvexIndex,
+                                           std::string& out_error)
+{
+	AABB2 vertexBounds = bufParse.ParseAABB2();
+	Vec2  stepSize     = (vertexBounds.m_maxs - vertexBounds.m_mins) * (1.f / GHCS_QUANTIZED_MAX_STEP);
+	int   numObjects   = static_cast<int>(bufParse.ParseUint32());
+	std::vector<Vec2> verts;
+	for (int i = 0; i < numObjects && firstConvexIndex + i < static_cast<int>(convexes.size()); ++i)
+	{
+		uint32_t numVerts = ParseVarUint32_SCJ(bufParse);
+		if (!DoRecordsFit_SCJ(bufParse, dataSize, numVerts, 2 * sizeof(uint16_t)))
+		{
+			out_error = Stringf("object %d lists %u vertices past the end of the chunk", i, numVerts);
+			return false;
+		}
+		verts.clear();
+		for (uint32_t j = 0; j < numVerts; ++j)
+		{
+			float qx = static_cast<float>(bufParse.ParseUshort());
+			float qy = static_cast<float>(bufParse.ParseUshort());
+			verts.push_back(Vec2(vertexBounds.m_mins.x + qx * stepSize.x, vertexBounds.m_mins.y + qy * stepSize.y));
+		}
+		convexes[firstConvexIndex + i]->m_convexPoly = ConvexPoly2(verts);
+	}
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+static void DecodeConvexHulls_SCJ(BufferParser& bufParse, bool const wideIndices, std::vector<Convex2*> const& convexes)
+{
+	int numObjects = static_cast<int>(ParseObjectIndex_SCJ(bufParse, wideIndices));
+	std::vector<Plane2> planes;
+	for (int i = 0; i < numObjects && i < static_cast<int>(convexes.size()); ++i)
+	{
+		uint8_t numPlanes = bufParse.ParseByte();
+		planes.clear();
+		for (int j = 0; j < static_cast<int>(numPlanes); ++j)
+		{
+			planes.push_back(bufParse.ParsePlane2());
+		}
+		convexes[i]->m_convexHull = ConvexHull2(planes);
+	}
+}
+
+//----------------------------------------------------------------------------------------------------
+// Node record: AABB2, two child indices and the convex count, followed by that many object indices
+//----------------------------------------------------------------------------------------------------
+static bool DecodeAABB2Tree_SCJ(BufferParser& bufParse, size_t const dataSize, bool const wideIndices, AABB2Tree& out_tree, bool& out_hasStoredLayout,
+                                std::vector<std::vector<uint32_t>>& out_nodeObjectIndices, std::string& out_error)
+{
+	constexpr size_t MIN_NODE_BYTES = sizeof(float) * 4 + sizeof(int32_t) * 2 + sizeof(uint32_t);
+	size_t const     indexBytes     = wideIndices ? sizeof(uint32_t) : sizeof(uint16_t);
+
+	uint8_t layout = bufParse.ParseByte();
+	out_hasStoredLayout = (layout == GHCS_BVH_LAYOUT_STORED);
+	if (out_hasStoredLayout)
+	{
+		uint8_t buildMethod = bufParse.ParseByte();
+		out_tree.SetBuildMethod(buildMethod == static_cast<uint8_t>(eAABB2TreeBuildMethod::SAH) ? eAABB2TreeBuildMethod::SAH
+		                                                                                         : eAABB2TreeBuildMethod::MIDPOINT);
+		out_tree.SetStartOfLastLevel(bufParse.ParseInt32());
+	}
+
+	unsigned int numNodes = bufParse.ParseUint32();
+	if (!DoRecordsFit_SCJ(bufParse, dataSize, numNodes, MIN_NODE_BYTES))
+	{
+		out_error = Stringf("%u nodes do not fit in %u bytes", numNodes, static_cast<unsigned int>(dataSize));
+		return false;
+	}
+	out_tree.m_nodes.resize(numNodes);
+	out_nodeObjectIndices.assign(numNodes, std::vector<uint32_t>());
+	for (unsigned int n = 0; n < numNodes; ++n)
+	{
+		out_tree.m_nodes[n].m_bounds = bufParse.ParseAABB2();
+		int leftChildIdx  = bufParse.ParseInt32();
+		int rightChildIdx = bufParse.ParseInt32();
+		bool validChildren = (leftChildIdx > 0 && rightChildIdx > 0 &&
+		                      leftChildIdx < static_cast<int>(numNodes) && rightChildIdx < static_cast<int>(numNodes));
+		out_tree.m_nodes[n].m_leftChild  = validChildren ? leftChildIdx : -1;
+		out_tree.m_nodes[n].m_rightChild = validChildren ? rightChildIdx : -1;
+		unsigned int numConvex = bufParse.ParseUint32();
+		if (!DoRecordsFit_SCJ(bufParse, dataSize, numConvex, indexBytes))
+		{
+			out_error = Stringf("node %u lists %u convexes past the end of the chunk", n, numConvex);
+			return false;
+		}
+		out_nodeObjectIndices[n].resize(numConvex);
+		for (unsigned int c = 0; c < numConvex; ++c)
+		{
+			out_nodeObjectIndices[n][c] = ParseObjectIndex_SCJ(bufParse, wideIndices);
+		}
+	}
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// QuadKey entries name a cell by (depth, x, y); the full tree down to the deepest entry is rebuilt over
+// sceneBounds and each entry's indices land on its cell
+//----------------------------------------------------------------------------------------------------
+static bool DecodeSymQuadTree_SCJ(BufferParser& bufParse, size_t const dataSize, bool const wideIndices, AABB2 const& sceneBounds, SymmetricQuadTree& out_tree,
+                                  std::vector<std::vector<uint32_t>>& out_nodeObjectIndices, std::string& out_error)
+{
+	size_t const indexBytes    = wideIndices ? sizeof(uint32_t) : sizeof(uint16_t);
+	size_t const minEntryBytes = sizeof(uint8_t) + sizeof(uint16_t) * 2 + indexBytes;
+
+	unsigned int numEntries = bufParse.ParseUint32();
+	if (!DoRecordsFit_SCJ(bufParse, dataSize, numEntries, minEntryBytes))
+	{
+		out_error = Stringf("%u cells do not fit in %u bytes", numEntries, static_cast<unsigned int>(dataSize));
+		return false;
+	}
+
+	size_t savedPos = bufParse.GetCurrentPosition();
+	int maxDepth = 0;
+	for (unsigned int e = 0; e < numEntries; ++e)
+	{
+		uint8_t entryDepth = bufParse.ParseByte();
+		if (static_cast<int>(entryDepth) >= MAX_SYMMETRIC_QUAD_TREE_LEVELS)
+		{
+			out_error = Stringf("cell depth %d exceeds the %d-level limit", static_cast<int>(entryDepth), MAX_SYMMETRIC_QUAD_TREE_LEVELS);
+			return false;
+		}
+		if (static_cast<int>(entryDepth) > maxDepth) maxDepth = static_cast<int>(entryDepth);
+		bufParse.ParseUshort();
+		bufParse.ParseUshort();
+		uint32_t numConvex = ParseObjectIndex_SCJ(bufParse, wideIndices);
+		if (!DoRecordsFit_SCJ(bufParse, dataSize, numConvex, indexBytes))
+		{
+			out_error = Stringf("cell %u lists %u convexes past the end of the chunk", e, numConvex);
+			return false;
+		}
+		for (uint32_t c = 0; c < numConvex; ++c) ParseObjectIndex_SCJ(bufParse, wideIndices);
+	}
+
+	int totalNodes = 0;
+	{ int ls = 1; for (int d = 0; d <= maxDepth; ++d) { totalNodes += ls; ls *= 4; } }
+	out_tree.m_nodes.resize(totalNodes);
+	out_nodeObjectIndices.assign(totalNodes, std::vector<uint32_t>());
+
+	// Reconstruct bounds
+	{
+		Vec2 worldMins = sceneBounds.m_mins;
+		Vec2 worldSize = Vec2(sceneBounds.m_maxs.x - sceneBounds.m_mins.x, sceneBounds.m_maxs.y - sceneBounds.m_mins.y);
+		int levelStart = 0;
+		int levelSize  = 1;
+		for (int d = 0; d <= maxDepth; ++d)
+		{
+			int gridDim = 1 << d;
+			Vec2 cellSize = Vec2(worldSize.x / static_cast<float>(gridDim), worldSize.y / static_cast<float>(gridDim));
+			for (int j = 0; j < levelSize && (levelStart + j) < totalNodes; ++j)
+			{
+				int gx = j % gridDim;
+				int gy = j / gridDim;
+				Vec2 mins = worldMins + Vec2(static_cast<float>(gx) * cellSize.x, static_cast<float>(gy) * cellSize.y);
+				out_tree.m_nodes[levelStart + j].m_bounds = AABB2(mins, mins + cellSize);
+			}
+			levelStart += levelSize;
+			levelSize *= 4;
+		}
+	}
+
+	// Collect object indices per cell
+	bufParse.SetCurrentPosition(savedPos);
+	for (unsigned int e = 0; e < numEntries; ++e)
+	{
+		uint8_t  entryDepth = bufParse.ParseByte();
+		uint16_t qx = bufParse.ParseUshort();
+		uint16_t qy = bufParse.ParseUshort();
+		int levelStart = 0;
+		{ int ls = 1; for (int d = 0; d < static_cast<int>(entryDepth); ++d) { levelStart += ls; ls *= 4; } }
+		int gridDim = 1 << entryDepth;
+		int nodeIdx = levelStart + static_cast<int>(qy) * gridDim + static_cast<int>(qx);
+		uint32_t numConvex = ParseObjectIndex_SCJ(bufParse, wideIndices);
+		for (uint32_t c = 0; c < numConvex; ++c)
+		{
+			uint32_t objIdx = ParseObjectIndex_SCJ(bufParse, wideIndices);
+			if (nodeIdx < totalNodes) out_nodeObjectIndices[nodeIdx].push_back(objIdx);
+		}
+	}
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void SceneChunkDecodeJob::Execute()
+{
+	auto startTime = std::chrono::steady_clock::now();
+
+	BufferParser bufParse(m_chunkData, static_cast<size_t>(m_dataSize));
+	if (m_chunkEndian == 1) bufParse.SetEndianMode(eEndianMode::LITTLE);
+	else if (m_chunkEndian == 2) bufParse.SetEndianMode(eEndianMode::BIG);
+
+	if (m_chunkType == 0x02) // ConvexPolys
+	{
+		DecodeConvexPolys_SCJ(bufParse, m_wideIndices, m_convexes, m_firstConvexIndex);
+	}
+	else if (m_chunkType == 0x03) // QuantizedConvexPolys
+	{
+		DecodeQuantizedConvexPolys_SCJ(bufParse, m_dataSize, m_convexes, m_firstConvexIndex, m_decodeError);
+	}
+	else if (m_chunkType == 0x80) // ConvexHulls
+	{
+		DecodeConvexHulls_SCJ(bufParse, m_wideIndices, m_convexes);
+	}
+	else if (m_chunkType == 0x81) // BoundingDiscs
+	{
+		int numObjects = static_cast<int>(ParseObjectIndex_SCJ(bufParse, m_wideIndices));
+		for (int i = 0; i < numObjects && i < static_cast<int>(m_convexes.size()); ++i)
+		{
+			m_convexes[i]->m_boundingDiscCenter = bufParse.ParseVec2();
+			m_convexes[i]->m_boundingRadius     = bufParse.ParseFloat();
+		}
+	}
+	else if (m_chunkType == 0x82) // BoundingAABBs
+	{
+		int numObjects = static_cast<int>(ParseObjectIndex_SCJ(bufParse, m_wideIndices));
+		for (int i = 0; i < numObjects && i < static_cast<int>(m_convexes.size()); ++i)
+		{
+			m_convexes[i]->m_boundingAABB = bufParse.ParseAABB2();
+		}
+	}
+	else if (m_chunkType == 0x83) // AABB2 Tree (BVH)
+	{
+		if (!DecodeAABB2Tree_SCJ(bufParse, m_dataSize, m_wideIndices, m_AABB2Tree, m_hasStoredTreeLayout, m_nodeObjectIndices, m_decodeError))
+		{
+			m_AABB2Tree.m_nodes.clear();
+			m_nodeObjectIndices.clear();
+		}
+	}
+	else if (m_chunkType == 0x87) // Symmetric Quadtree (QuadKey format)
+	{
+		if (!DecodeSymQuadTree_SCJ(bufParse, m_dataSize, m_wideIndices, m_sceneBounds, m_symQuadTree, m_nodeObjectIndices, m_decodeError))
+		{
+			m_symQuadTree.m_nodes.clear();
+			m_nodeObjectIndices.clear();
+		}
+	}
+
+	m_decodeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+//----------------------------------------------------------------------------------------------------
+void RunSceneChunkJobs(std::vector<SceneChunkDecodeJob*> const& jobs)
+{
+	if (jobs.size() == 1)
+	{
+		jobs[0]->Execute();
+		return;
+	}
+
+	for (SceneChunkDecodeJob* job : jobs)
+	{
+		g_jobSystem->SubmitJob(job);
+	}
+
+	// Completed jobs share one queue, so check each one belongs to this load before counting it
+	std::vector<SceneChunkDecodeJob*> outstandingJobs = jobs;
+	while (!outstandingJobs.empty())
+	{
+		Job* completedJob = g_jobSystem->RetrieveCompletedJob();
+		if (completedJob == nullptr)
+		{
+			std::this_thread::yield();
+			continue;
+		}
+		auto found = std::find(outstandingJobs.begin(), outstandingJobs.end(), completedJob);
+		GUARANTEE_OR_DIE(found != outstandingJobs.end(), "RunSceneChunkJobs retrieved a job it did not submit");
+		outstandingJobs.erase(found);
+	}
+}
+
+//----------------------------------------------------------------------------------------------------
+void ResolveNodeObjectIndices(std::vector<std::vector<uint32_t>> const& nodeObjectIndices, std::vector<Convex2*> const& convexes,
+                              std::vector<std::vector<Convex2*>>& out_nodeContents)
+{
+	out_nodeContents.assign(nodeObjectIndices.size(), std::vector<Convex2*>());
+	for (size_t n = 0; n < nodeObjectIndices.size(); ++n)
+	{
+		out_nodeContents[n].reserve(nodeObjectIndices[n].size());
+		for (uint32_t objIdx : nodeObjectIndices[n])
+		{
+			if (objIdx < convexes.size())
+			{
+				out_nodeContents[n].push_back(convexes[objIdx]);
+			}
+		}
+	}
+}
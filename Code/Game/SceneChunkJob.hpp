@@ -0,0 +1,84 @@
+//----------------------------------------------------------------------------------------------------
+// SceneChunkJob.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include "Game/BVH.hpp"
+#include "Game/QuadTree.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/JobSystem.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+struct Convex2;
+
+//----------------------------------------------------------------------------------------------------
+// Chunk 0x03 (QuantizedConvexPolys) maps every vertex coordinate to a step in [0, GHCS_QUANTIZED_MAX_STEP]
+// across the AABB2 of all vertices stored at the start of the chunk, rounding to the nearest step.
+// Worst-case position error per axis is half a step: extent / (2 * 65535), e.g. 0.0015 units on the 200-unit
+// wide default world, and at most sqrt(2) times that as a distance.
+//----------------------------------------------------------------------------------------------------
+constexpr float GHCS_QUANTIZED_MAX_STEP = 65535.f;
+
+//----------------------------------------------------------------------------------------------------
+// First byte of chunk 0x83. INFERRED trees only hold nodes, so the loader guesses the build method from the
+// child order and the last level from the node count. STORED trees follow it with the build method (uint8)
+// and start of the last level (int32), and list convexes on leaves only; a file may hold one per build method.
+//----------------------------------------------------------------------------------------------------
+constexpr uint8_t GHCS_BVH_LAYOUT_INFERRED = 1;
+constexpr uint8_t GHCS_BVH_LAYOUT_STORED   = 2;
+
+//----------------------------------------------------------------------------------------------------
+// SceneChunkDecodeJob - Decodes one GHCS chunk (0x02, 0x03, 0x80-0x83 or 0x87) straight from the file bytes on
+// a worker thread.
+//
+// The loader creates every Convex2 before any job runs, so the per-object chunks only write their own
+// members of already existing convexes (polys, hulls, discs, AABBs) and never touch shared containers.
+// Tree chunks keep their object indices in m_nodeObjectIndices; the loader resolves them to Convex2*
+// once every chunk is done, since they may name convexes another job is still filling in.
+//
+// Object counts and indices are uint16 up to GHCS 2.1 and uint32 from 2.2 on (m_wideIndices).
+// Tree chunks and 0x03 check every count read from the file against the bytes left in the chunk before
+// allocating for it; a chunk that fails sets m_decodeError. A rejected tree is left empty and rebuilt by the
+// loader, a rejected 0x03 fails the load.
+//----------------------------------------------------------------------------------------------------
+class SceneChunkDecodeJob : public Job
+{
+public:
+	SceneChunkDecodeJob(uint8_t chunkType, uint8_t chunkEndian, bool wideIndices, unsigned char const* chunkData, unsigned int dataSize,
+	                    std::vector<Convex2*> const& convexes, int firstConvexIndex, AABB2 const& sceneBounds);
+
+	void Execute() override;
+
+	uint8_t                      m_chunkType   = 0;
+	uint8_t                      m_chunkEndian = 0;
+	bool                         m_wideIndices = false;
+	unsigned char const*         m_chunkData   = nullptr;   // First byte after the chunk's dataSize field
+	unsigned int                 m_dataSize    = 0;
+	std::vector<Convex2*> const& m_convexes;
+	int                          m_firstConvexIndex = 0;    // 0x02 / 0x03 only: slot of this chunk's first object
+	AABB2                        m_sceneBounds;             // 0x87 only: the quadtree cells are rebuilt from it
+
+	AABB2Tree                          m_AABB2Tree;         // 0x83: bounds and children, no contents yet
+	bool                               m_hasStoredTreeLayout = false;   // 0x83: build method and last level were read
+	SymmetricQuadTree                  m_symQuadTree;       // 0x87: cell bounds, no contents yet
+	std::vector<std::vector<uint32_t>> m_nodeObjectIndices; // 0x83 / 0x87: object indices per node
+	std::string                        m_decodeError;       // 0x03 / 0x83 / 0x87: why the chunk was rejected, empty when it decoded
+	double                             m_decodeMs = 0.0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Runs every job on the JobSystem (inline when there is only one) and blocks until all are done.
+// The jobs stay owned by the caller so it can read their results.
+//----------------------------------------------------------------------------------------------------
+void RunSceneChunkJobs(std::vector<SceneChunkDecodeJob*> const& jobs);
+
+//----------------------------------------------------------------------------------------------------
+// Dependency step: maps a tree chunk's object indices onto the decoded convexes, dropping out-of-range ones
+//----------------------------------------------------------------------------------------------------
+void ResolveNodeObjectIndices(std::vector<std::vector<uint32_t>> const& nodeObjectIndices, std::vector<Convex2*> const& convexes,
+                              std::vector<std::vector<Convex2*>>& out_nodeContents);
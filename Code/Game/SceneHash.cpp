@@ -0,0 +1,181 @@
+//----------------------------------------------------------------------------------------------------
+// SceneHash.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/SceneHash.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <bit>
+#include <cstring>
+
+//----------------------------------------------------------------------------------------------------
+constexpr uint64_t XXH_PRIME64_1 = 0x9E3779B185EBCA87ull;
+constexpr uint64_t XXH_PRIME64_2 = 0xC2B2AE3D27D4EB4Full;
+constexpr uint64_t XXH_PRIME64_3 = 0x165667B19E3779F9ull;
+constexpr uint64_t XXH_PRIME64_4 = 0x85EBCA77C2B2AE63ull;
+constexpr uint64_t XXH_PRIME64_5 = 0x27D4EB2F165667C5ull;
+
+//----------------------------------------------------------------------------------------------------
+// xxHash reads its input as little-endian words whatever the host is
+//----------------------------------------------------------------------------------------------------
+static uint64_t ReadUint64LE_HASH(unsigned char const* data)
+{
+	uint64_t value = 0;
+	if constexpr (std::endian::native == std::endian::little)
+	{
+		std::memcpy(&value, data, sizeof(value));
+	}
+	else
+	{
+		for (int b = 7; b >= 0; --b) value = (value << 8) | data[b];
+	}
+	return value;
+}
+
+//----------------------------------------------------------------------------------------------------
+static uint32_t ReadUint32LE_HASH(unsigned char const* data)
+{
+	uint32_t value = 0;
+	if constexpr (std::endian::native == std::endian::little)
+	{
+		std::memcpy(&value, data, sizeof(value));
+	}
+	else
+	{
+		for (int b = 3; b >= 0; --b) value = (value << 8) | data[b];
+	}
+	return value;
+}
+
+//----------------------------------------------------------------------------------------------------
+static uint64_t Round_HASH(uint64_t acc, uint64_t const input)
+{
+	acc += input * XXH_PRIME64_2;
+	acc  = std::rotl(acc, 31);
+	return acc * XXH_PRIME64_1;
+}
+
+//----------------------------------------------------------------------------------------------------
+static uint64_t MergeRound_HASH(uint64_t acc, uint64_t const val)
+{
+	acc ^= Round_HASH(0, val);
+	return acc * XXH_PRIME64_1 + XXH_PRIME64_4;
+}
+
+//----------------------------------------------------------------------------------------------------
+// The four lane accumulators have no dependency on each other, so the CPU overlaps their multiplies and
+// each 32-byte stripe costs about as much as one byte did in the rolling hashes
+//----------------------------------------------------------------------------------------------------
+uint64_t ComputeXXHash64(unsigned char const* data, size_t const numBytes, uint64_t const seed)
+{
+	unsigned char const* cursor = data;
+	unsigned char const* end    = data + numBytes;
+	uint64_t hash;
+
+	if (numBytes >= 32)
+	{
+		uint64_t v1 = seed + XXH_PRIME64_1 + XXH_PRIME64_2;
+		uint64_t v2 = seed + XXH_PRIME64_2;
+		uint64_t v3 = seed;
+		uint64_t v4 = seed - XXH_PRIME64_1;
+
+		unsigned char const* lastStripe = end - 32;
+		do
+		{
+			v1 = Round_HASH(v1, ReadUint64LE_HASH(cursor));
+			v2 = Round_HASH(v2, ReadUint64LE_HASH(cursor + 8));
+			v3 = Round_HASH(v3, ReadUint64LE_HASH(cursor + 16));
+			v4 = Round_HASH(v4, ReadUint64LE_HASH(cursor + 24));
+			cursor += 32;
+		} while (cursor <= lastStripe);
+
+		hash = std::rotl(v1, 1) + std::rotl(v2, 7) + std::rotl(v3, 12) + std::rotl(v4, 18);
+		hash = MergeRound_HASH(hash, v1);
+		hash = MergeRound_HASH(hash, v2);
+		hash = MergeRound_HASH(hash, v3);
+		hash = MergeRound_HASH(hash, v4);
+	}
+	else
+	{
+		hash = seed + XXH_PRIME64_5;
+	}
+
+	hash += static_cast<uint64_t>(numBytes);
+
+	// Tail: 8, then 4, then 1 byte at a time
+	for (; cursor + 8 <= end; cursor += 8)
+	{
+		hash ^= Round_HASH(0, ReadUint64LE_HASH(cursor));
+		hash  = std::rotl(hash, 27) * XXH_PRIME64_1 + XXH_PRIME64_4;
+	}
+	if (cursor + 4 <= end)
+	{
+		hash ^= static_cast<uint64_t>(ReadUint32LE_HASH(cursor)) * XXH_PRIME64_1;
+		hash  = std::rotl(hash, 23) * XXH_PRIME64_2 + XXH_PRIME64_3;
+		cursor += 4;
+	}
+	for (; cursor < end; ++cursor)
+	{
+		hash ^= static_cast<uint64_t>(*cursor) * XXH_PRIME64_5;
+		hash  = std::rotl(hash, 11) * XXH_PRIME64_1;
+	}
+
+	// Avalanche
+	hash ^= hash >> 33;
+	hash *= XXH_PRIME64_2;
+	hash ^= hash >> 29;
+	hash *= XXH_PRIME64_3;
+	hash ^= hash >> 32;
+	return hash;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool IsKnownGHCSHashType(uint8_t const hashType)
+{
+	return hashType == static_cast<uint8_t>(eGHCSHashType::ROLLING) ||
+	       hashType == static_cast<uint8_t>(eGHCSHashType::FNV1A) ||
+	       hashType == static_cast<uint8_t>(eGHCSHashType::XXHASH64);
+}
+
+//----------------------------------------------------------------------------------------------------
+char const* GetGHCSHashTypeName(eGHCSHashType const hashType)
+{
+	switch (hashType)
+	{
+	case eGHCSHashType::ROLLING:  return "rolling";
+	case eGHCSHashType::FNV1A:    return "FNV-1a";
+	case eGHCSHashType::XXHASH64: return "xxHash64";
+	default:                      return "none";
+	}
+}
+
+//----------------------------------------------------------------------------------------------------
+uint32_t ComputeGHCSHash(eGHCSHashType const hashType, unsigned char const* data, size_t const numBytes)
+{
+	if (hashType == eGHCSHashType::ROLLING)
+	{
+		uint32_t hash = 0;
+		for (size_t i = 0; i < numBytes; ++i)
+		{
+			hash *= 31;
+			hash += data[i];
+		}
+		return hash;
+	}
+	if (hashType == eGHCSHashType::FNV1A)
+	{
+		uint32_t hash = 2166136261u;
+		for (size_t i = 0; i < numBytes; ++i)
+		{
+			hash ^= data[i];
+			hash *= 16777619u;
+		}
+		return hash;
+	}
+	if (hashType == eGHCSHashType::XXHASH64)
+	{
+		uint64_t hash = ComputeXXHash64(data, numBytes);
+		return static_cast<uint32_t>(hash ^ (hash >> 32));
+	}
+	return 0;
+}
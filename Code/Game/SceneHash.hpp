@@ -0,0 +1,30 @@
+//----------------------------------------------------------------------------------------------------
+// SceneHash.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include <cstddef>
+#include <cstdint>
+
+//----------------------------------------------------------------------------------------------------
+// Data hash types stored in byte 12 of the GHCS header. The hash covers every byte after the 28-byte header.
+//
+// ROLLING and FNV1A consume one byte per multiply, a serial dependency chain that tops out near 1 byte/cycle.
+// XXHASH64 runs four independent 64-bit lanes over 32-byte stripes and is folded to the header's 32 bits,
+// so hashing stays far below parse time on multi-megabyte scenes. Unknown types are skipped on load.
+//----------------------------------------------------------------------------------------------------
+enum class eGHCSHashType : uint8_t
+{
+	NONE     = 0,
+	ROLLING  = 1,   // hash = hash * 31 + byte
+	FNV1A    = 2,   // 32-bit FNV-1a
+	XXHASH64 = 3,   // xxHash64 (seed 0), upper and lower halves XOR-folded
+};
+
+//----------------------------------------------------------------------------------------------------
+bool        IsKnownGHCSHashType(uint8_t hashType);
+char const* GetGHCSHashTypeName(eGHCSHashType hashType);
+uint32_t    ComputeGHCSHash(eGHCSHashType hashType, unsigned char const* data, size_t numBytes);
+uint64_t    ComputeXXHash64(unsigned char const* data, size_t numBytes, uint64_t seed = 0);
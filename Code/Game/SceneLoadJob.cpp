@@ -0,0 +1,22 @@
+//----------------------------------------------------------------------------------------------------
+// SceneLoadJob.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/SceneLoadJob.hpp"
+
+//----------------------------------------------------------------------------------------------------
+ConvexSceneLoadJob::ConvexSceneLoadJob(std::string const& filePath, AABB2 const& fallbackBounds)
+	: Job(JOB_TYPE_IO)
+	, m_filePath(filePath)
+	, m_fallbackBounds(fallbackBounds)
+	, m_submitTime(std::chrono::steady_clock::now())
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+void ConvexSceneLoadJob::Execute()
+{
+	m_succeeded = GameConvexScene::ParseSceneFile(m_filePath, m_fallbackBounds, false, m_loadedScene, &m_progress);
+	m_progress.m_stage = eSceneLoadStage::DONE;
+}
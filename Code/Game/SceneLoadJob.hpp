@@ -0,0 +1,35 @@
+//----------------------------------------------------------------------------------------------------
+// SceneLoadJob.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include "Game/GameConvexScene.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Core/JobSystem.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <chrono>
+#include <string>
+
+//----------------------------------------------------------------------------------------------------
+// ConvexSceneLoadJob - Maps, validates and decodes a whole GHCS file on the JobSystem I/O thread and builds
+// the spatial structures it did not carry, all into m_loadedScene.
+//
+// Nothing here touches the running scene: GameConvexScene polls m_progress each frame and swaps
+// m_loadedScene in at the start of the frame after the job completes. The chunks are decoded inline
+// because waiting on generic workers from here would race the main thread's poll for this job.
+//----------------------------------------------------------------------------------------------------
+class ConvexSceneLoadJob : public Job
+{
+public:
+	ConvexSceneLoadJob(std::string const& filePath, AABB2 const& fallbackBounds);
+
+	void Execute() override;
+
+	std::string       m_filePath;
+	AABB2             m_fallbackBounds;     // Tree bounds when the file has no SceneInfo chunk
+	LoadedConvexScene m_loadedScene;
+	SceneLoadProgress m_progress;
+	bool              m_succeeded = false;
+	std::chrono::steady_clock::time_point m_submitTime;
+};
@@ -0,0 +1,245 @@
+//----------------------------------------------------------------------------------------------------
+// UniformGrid.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/UniformGrid.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Game/Convex.hpp"
+#include "Game/RaySlab.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Math/RaycastUtils.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+//----------------------------------------------------------------------------------------------------
+constexpr int   MAX_GRID_CELLS_PER_AXIS = 4096;
+constexpr float GRID_INSERT_PADDING     = 1e-4f;   // Of a cell: a convex touching a cell corner is listed on both sides
+
+//----------------------------------------------------------------------------------------------------
+// GridWalk_UG - DDA state: the current cell, the ray distance to its next x / y boundary and the
+// distance one cell spans along the ray per axis.
+//----------------------------------------------------------------------------------------------------
+struct GridWalk_UG
+{
+	int   m_cellX   = 0;
+	int   m_cellY   = 0;
+	int   m_stepX   = 1;
+	int   m_stepY   = 1;
+	float m_tMaxX   = FLT_MAX;
+	float m_tMaxY   = FLT_MAX;
+	float m_tDeltaX = FLT_MAX;
+	float m_tDeltaY = FLT_MAX;
+
+	float GetCellExitDist() const { return std::min(m_tMaxX, m_tMaxY); }
+};
+
+//----------------------------------------------------------------------------------------------------
+// Clips the ray to the grid and sets up the walk at the cell it enters first; false when it misses the grid
+//----------------------------------------------------------------------------------------------------
+static bool BeginGridWalk_UG(UniformGrid2D const& grid, RaySlab2D const& ray, GridWalk_UG& out_walk)
+{
+	Vec2 const& startPos   = ray.m_startPos;
+	Vec2 const& forwardVec = ray.m_forwardVec;
+	float       entryDist;
+	if (grid.m_cellStart.empty() || !ray.HitsAABB2(grid.m_bounds, entryDist))
+	{
+		return false;
+	}
+
+	Vec2 const entryPos = startPos + forwardVec * entryDist;
+	out_walk.m_cellX = std::clamp(static_cast<int>(floorf((entryPos.x - grid.m_bounds.m_mins.x) / grid.m_cellSizeX)), 0, grid.m_numCellsX - 1);
+	out_walk.m_cellY = std::clamp(static_cast<int>(floorf((entryPos.y - grid.m_bounds.m_mins.y) / grid.m_cellSizeY)), 0, grid.m_numCellsY - 1);
+
+	float const invForwardX = ray.m_invForward.x;
+	float const invForwardY = ray.m_invForward.y;
+	out_walk.m_stepX   = (forwardVec.x >= 0.f) ? 1 : -1;
+	out_walk.m_stepY   = (forwardVec.y >= 0.f) ? 1 : -1;
+	out_walk.m_tDeltaX = grid.m_cellSizeX * fabsf(invForwardX);
+	out_walk.m_tDeltaY = grid.m_cellSizeY * fabsf(invForwardY);
+
+	float const nextBoundaryX = grid.m_bounds.m_mins.x + static_cast<float>(out_walk.m_cellX + (out_walk.m_stepX > 0 ? 1 : 0)) * grid.m_cellSizeX;
+	float const nextBoundaryY = grid.m_bounds.m_mins.y + static_cast<float>(out_walk.m_cellY + (out_walk.m_stepY > 0 ? 1 : 0)) * grid.m_cellSizeY;
+	out_walk.m_tMaxX = (nextBoundaryX - startPos.x) * invForwardX;
+	out_walk.m_tMaxY = (nextBoundaryY - startPos.y) * invForwardY;
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Moves to the next cell along the ray; false once the ray leaves the grid
+//----------------------------------------------------------------------------------------------------
+static bool StepGridWalk_UG(UniformGrid2D const& grid, GridWalk_UG& walk)
+{
+	if (walk.m_tMaxX < walk.m_tMaxY)
+	{
+		walk.m_cellX += walk.m_stepX;
+		walk.m_tMaxX += walk.m_tDeltaX;
+		return walk.m_cellX >= 0 && walk.m_cellX < grid.m_numCellsX;
+	}
+	walk.m_cellY += walk.m_stepY;
+	walk.m_tMaxY += walk.m_tDeltaY;
+	return walk.m_cellY >= 0 && walk.m_cellY < grid.m_numCellsY;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Inclusive cell range overlapped by box, grown by GRID_INSERT_PADDING so rays through a corner see it
+//----------------------------------------------------------------------------------------------------
+static void GetCellRange_UG(UniformGrid2D const& grid, AABB2 const& box, int& out_minX, int& out_minY, int& out_maxX, int& out_maxY)
+{
+	float const invCellX = 1.f / grid.m_cellSizeX;
+	float const invCellY = 1.f / grid.m_cellSizeY;
+	out_minX = std::clamp(static_cast<int>(floorf((box.m_mins.x - grid.m_bounds.m_mins.x) * invCellX - GRID_INSERT_PADDING)), 0, grid.m_numCellsX - 1);
+	out_minY = std::clamp(static_cast<int>(floorf((box.m_mins.y - grid.m_bounds.m_mins.y) * invCellY - GRID_INSERT_PADDING)), 0, grid.m_numCellsY - 1);
+	out_maxX = std::clamp(static_cast<int>(floorf((box.m_maxs.x - grid.m_bounds.m_mins.x) * invCellX + GRID_INSERT_PADDING)), 0, grid.m_numCellsX - 1);
+	out_maxY = std::clamp(static_cast<int>(floorf((box.m_maxs.y - grid.m_bounds.m_mins.y) * invCellY + GRID_INSERT_PADDING)), 0, grid.m_numCellsY - 1);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Two passes over the convexes: count per cell, prefix-sum into m_cellStart, then scatter
+//----------------------------------------------------------------------------------------------------
+void UniformGrid2D::BuildGrid(std::vector<Convex2*> const& convexArray, float const cellsPerConvex)
+{
+	m_cellStart.clear();
+	m_cellConvexes.clear();
+	m_numCellsX = 0;
+	m_numCellsY = 0;
+	if (convexArray.empty())
+	{
+		return;
+	}
+
+	Vec2 mins(FLT_MAX, FLT_MAX);
+	Vec2 maxs(-FLT_MAX, -FLT_MAX);
+	for (Convex2 const* convex : convexArray)
+	{
+		AABB2 const& box = convex->m_boundingAABB;
+		mins.x = std::min(mins.x, box.m_mins.x);
+		mins.y = std::min(mins.y, box.m_mins.y);
+		maxs.x = std::max(maxs.x, box.m_maxs.x);
+		maxs.y = std::max(maxs.y, box.m_maxs.y);
+	}
+	m_bounds = AABB2(mins, maxs);
+
+	// Square cells, cellsPerConvex of them per convex over the scene bounds
+	float const numCells = std::max(cellsPerConvex * static_cast<float>(convexArray.size()), 1.f);
+	float const width    = std::max(maxs.x - mins.x, FLT_EPSILON);
+	float const height   = std::max(maxs.y - mins.y, FLT_EPSILON);
+	float const cellSize = sqrtf(width * height / numCells);
+
+	m_numCellsX = std::clamp(static_cast<int>(ceilf(width / cellSize)), 1, MAX_GRID_CELLS_PER_AXIS);
+	m_numCellsY = std::clamp(static_cast<int>(ceilf(height / cellSize)), 1, MAX_GRID_CELLS_PER_AXIS);
+	m_cellSizeX = width / static_cast<float>(m_numCellsX);
+	m_cellSizeY = height / static_cast<float>(m_numCellsY);
+
+	m_cellStart.assign(GetNumCells() + 1, 0);
+	for (Convex2 const* convex : convexArray)
+	{
+		int minX, minY, maxX, maxY;
+		GetCellRange_UG(*this, convex->m_boundingAABB, minX, minY, maxX, maxY);
+		for (int y = minY; y <= maxY; ++y)
+		{
+			for (int x = minX; x <= maxX; ++x)
+			{
+				++m_cellStart[y * m_numCellsX + x + 1];
+			}
+		}
+	}
+	for (int c = 0; c < GetNumCells(); ++c)
+	{
+		m_cellStart[c + 1] += m_cellStart[c];
+	}
+
+	m_cellConvexes.resize(m_cellStart.back());
+	std::vector<int> cursor(m_cellStart.begin(), m_cellStart.end() - 1);
+	for (Convex2* convex : convexArray)
+	{
+		int minX, minY, maxX, maxY;
+		GetCellRange_UG(*this, convex->m_boundingAABB, minX, minY, maxX, maxY);
+		for (int y = minY; y <= maxY; ++y)
+		{
+			for (int x = minX; x <= maxX; ++x)
+			{
+				m_cellConvexes[cursor[y * m_numCellsX + x]++] = convex;
+			}
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------
+// A convex spanning several cells may be tested once per cell; bestDist caps the repeat at the AABB check
+//----------------------------------------------------------------------------------------------------
+Convex2* UniformGrid2D::SolveRayClosestHit(Vec2 const& startPos, Vec2 const& forwardVec, float const maxDist, RaycastResult2D& out_closestHit) const
+{
+	out_closestHit.m_didImpact = false;
+	Convex2* closestConvex = nullptr;
+	float    bestDist      = maxDist;
+
+	// m_maxDist follows bestDist, so the rejection tests stop passing convexes behind the best hit
+	RaySlab2D   ray(startPos, forwardVec, bestDist);
+	GridWalk_UG walk;
+	if (!BeginGridWalk_UG(*this, ray, walk))
+	{
+		return nullptr;
+	}
+
+	RaycastResult2D rayRes;
+	do
+	{
+		int const cellIndex = walk.m_cellY * m_numCellsX + walk.m_cellX;
+		for (int i = m_cellStart[cellIndex]; i < m_cellStart[cellIndex + 1]; ++i)
+		{
+			Convex2* convex = m_cellConvexes[i];
+			if (convex->RayCastVsConvex2D<eRayRejection::DISC>(rayRes, ray) && rayRes.m_impactLength <= bestDist)
+			{
+				bestDist       = rayRes.m_impactLength;
+				ray.m_maxDist  = bestDist;
+				out_closestHit = rayRes;
+				closestConvex  = convex;
+			}
+		}
+
+		// Every later cell starts at or beyond this one's exit, so a hit before it is final
+		if (bestDist <= walk.GetCellExitDist())
+		{
+			break;
+		}
+	} while (StepGridWalk_UG(*this, walk));
+
+	return closestConvex;
+}
+
+//----------------------------------------------------------------------------------------------------
+void UniformGrid2D::SolveRayCells(Vec2 const& startPos, Vec2 const& forwardVec, float const maxDist, std::vector<int>& out_cellIndices) const
+{
+	GridWalk_UG walk;
+	if (!BeginGridWalk_UG(*this, RaySlab2D(startPos, forwardVec, maxDist), walk))
+	{
+		return;
+	}
+
+	do
+	{
+		out_cellIndices.push_back(walk.m_cellY * m_numCellsX + walk.m_cellX);
+		if (walk.GetCellExitDist() >= maxDist)
+		{
+			break;
+		}
+	} while (StepGridWalk_UG(*this, walk));
+}
+
+//----------------------------------------------------------------------------------------------------
+AABB2 UniformGrid2D::GetCellBounds(int const cellIndex) const
+{
+	int const  cellX = cellIndex % m_numCellsX;
+	int const  cellY = cellIndex / m_numCellsX;
+	Vec2 const mins(m_bounds.m_mins.x + static_cast<float>(cellX) * m_cellSizeX, m_bounds.m_mins.y + static_cast<float>(cellY) * m_cellSizeY);
+	return AABB2(mins, Vec2(mins.x + m_cellSizeX, mins.y + m_cellSizeY));
+}
+
+//----------------------------------------------------------------------------------------------------
+size_t UniformGrid2D::GetMemoryFootprintBytes() const
+{
+	return m_cellStart.capacity() * sizeof(int) + m_cellConvexes.capacity() * sizeof(Convex2*);
+}
@@ -0,0 +1,54 @@
+//----------------------------------------------------------------------------------------------------
+// UniformGrid.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Math/AABB2.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+struct Convex2;
+struct RaycastResult2D;
+struct Vec2;
+
+//----------------------------------------------------------------------------------------------------
+// UniformGrid2D - Flat grid of equal cells over the AABBs of every convex, walked with a 2D DDA
+// (Amanatides-Woo) so a ray visits cells strictly in order and no parent nodes are climbed.
+//
+// Cell lists are stored CSR: cell c owns m_cellConvexes[m_cellStart[c], m_cellStart[c + 1]) and a convex
+// is listed in every cell its AABB overlaps. Cells are sized from the convex count rather than the convex
+// extent: with the overlapping benchmark scenes, ~2 cells per convex walked faster than cells as wide as
+// a convex, which at 8192 convexes leave ~110 convexes per cell.
+//----------------------------------------------------------------------------------------------------
+class UniformGrid2D
+{
+public:
+	// Square cells over the union of the convex AABBs, about cellsPerConvex * convexArray.size() of them
+	void BuildGrid(std::vector<Convex2*> const& convexArray, float cellsPerConvex = 2.f);
+
+	// Raycasts cell contents in ray order. A hit inside the current cell ends the walk, since every later
+	// cell starts beyond it. Same contract as AABB2Tree::SolveRayClosestHit.
+	Convex2* SolveRayClosestHit(Vec2 const& startPos, Vec2 const& forwardVec, float maxDist, RaycastResult2D& out_closestHit) const;
+
+	// Appends the index of every cell the ray crosses, in the order the DDA visits them (debug drawing)
+	void SolveRayCells(Vec2 const& startPos, Vec2 const& forwardVec, float maxDist, std::vector<int>& out_cellIndices) const;
+
+	AABB2 GetCellBounds(int cellIndex) const;
+	int   GetNumCells() const { return m_numCellsX * m_numCellsY; }
+	int   GetNumCellConvexes(int cellIndex) const { return m_cellStart[cellIndex + 1] - m_cellStart[cellIndex]; }
+
+	// Heap bytes held by m_cellStart and m_cellConvexes
+	size_t GetMemoryFootprintBytes() const;
+
+	AABB2 m_bounds;
+	int   m_numCellsX = 0;
+	int   m_numCellsY = 0;
+	float m_cellSizeX = 1.f;
+	float m_cellSizeY = 1.f;
+
+	std::vector<int>      m_cellStart;      // GetNumCells() + 1 offsets into m_cellConvexes
+	std::vector<Convex2*> m_cellConvexes;
+};
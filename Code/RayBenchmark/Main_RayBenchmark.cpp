@@ -0,0 +1,566 @@
+//----------------------------------------------------------------------------------------------------
+// Main_RayBenchmark.cpp
+//
+// Headless version of GameConvexScene::TestRays. No window, renderer or DevConsole: it builds a random
+// convex scene, both spatial trees and a random ray batch, then prints one row per strategy.
+//
+// Usage: RayBenchmark [--objects 64,512,2048] [--rays 65536] [--repeat 3] [--format csv|json]
+//                     [--fan-size 0] [--packet-size 16] [--hull-bench] [--pick-bench]
+// --fan-size N > 0 casts coherent fans of N rays from one origin instead of independent random rays.
+// --hull-bench first times the exact convex test alone, per side count, and checks its results against the
+// Engine routine (stderr).
+// --pick-bench also times point-in-convex queries per scene, linear scan vs the tree batches (stderr).
+// Exit code is 1 when any strategy disagrees with the brute-force hit count, a rebuilt BVH kept convexes from
+// its earlier build, or a tree disagrees with the linear pick.
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/BVH.hpp"
+#include "Game/Convex.hpp"
+#include "Game/ConvexPool.hpp"
+#include "Game/ConvexSceneStore.hpp"
+#include "Game/QuadTree.hpp"
+#include "Game/RayBenchmark.hpp"
+#include "Game/RaySlab.hpp"
+#include "Game/UniformGrid.hpp"
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Engine/Math/RaycastUtils.hpp"
+//----------------------------------------------------------------------------------------------------
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+// Counts every global heap allocation so scene creation can report how many it made
+//----------------------------------------------------------------------------------------------------
+static size_t s_numHeapAllocations = 0;
+
+void* operator new(size_t size)
+{
+	++s_numHeapAllocations;
+	if (void* memory = std::malloc(size == 0 ? 1 : size)) return memory;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+	std::free(memory);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Same world and shape ranges as GameConvexScene
+//----------------------------------------------------------------------------------------------------
+constexpr float CONVEX_WORLD_SIZE_X  = 200.f;
+constexpr float CONVEX_WORLD_SIZE_Y  = 100.f;
+constexpr float MIN_CONVEX_RADIUS    = 2.f;
+constexpr float MAX_CONVEX_RADIUS    = 8.f;
+constexpr int   QUAD_TREE_DEPTH      = 4;
+constexpr float RAY_FAN_DEGREES      = 10.f;
+constexpr int   HULL_BENCH_CONVEXES  = 256;
+constexpr int   HULL_BENCH_RAYS      = 4096;
+constexpr float HULL_BENCH_TOLERANCE = 1e-4f;   // Relative; the two routines may round the last bit differently
+constexpr int   PICK_BENCH_POINTS    = 16384;
+
+//----------------------------------------------------------------------------------------------------
+enum class eOutputFormat : uint8_t
+{
+	CSV,
+	JSON
+};
+
+//----------------------------------------------------------------------------------------------------
+struct BenchmarkOptions
+{
+	std::vector<int> m_objectCounts = { 64, 512, 2048 };
+	int              m_numRays      = 65536;
+	int              m_numRepeats   = 3;
+	int              m_fanSize      = 0;    // 0 = independent random rays
+	int              m_packetSize   = MAX_RAY_PACKET_SIZE;
+	bool             m_hullBench    = false;
+	bool             m_pickBench    = false;
+	eOutputFormat    m_format       = eOutputFormat::CSV;
+};
+
+//----------------------------------------------------------------------------------------------------
+struct BenchmarkRow
+{
+	int               m_numObjects   = 0;
+	int               m_numRays      = 0;
+	int               m_baselineHits = 0;
+	RayStrategyResult m_result;
+};
+
+//----------------------------------------------------------------------------------------------------
+static std::vector<int> ParseIntList(char const* text)
+{
+	std::vector<int> values;
+	std::string      token;
+	for (char const* c = text; ; ++c)
+	{
+		if (*c == ',' || *c == '\0')
+		{
+			if (!token.empty()) values.push_back(std::atoi(token.c_str()));
+			token.clear();
+			if (*c == '\0') break;
+		}
+		else
+		{
+			token += *c;
+		}
+	}
+	return values;
+}
+
+//----------------------------------------------------------------------------------------------------
+static bool ParseOptions(int argc, char** argv, BenchmarkOptions& out_options)
+{
+	for (int i = 1; i < argc; ++i)
+	{
+		bool hasValue = (i + 1 < argc);
+		if (std::strcmp(argv[i], "--objects") == 0 && hasValue)
+		{
+			out_options.m_objectCounts = ParseIntList(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--rays") == 0 && hasValue)
+		{
+			out_options.m_numRays = std::atoi(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--repeat") == 0 && hasValue)
+		{
+			out_options.m_numRepeats = std::atoi(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--fan-size") == 0 && hasValue)
+		{
+			out_options.m_fanSize = std::atoi(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--packet-size") == 0 && hasValue)
+		{
+			out_options.m_packetSize = std::atoi(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--hull-bench") == 0)
+		{
+			out_options.m_hullBench = true;
+		}
+		else if (std::strcmp(argv[i], "--pick-bench") == 0)
+		{
+			out_options.m_pickBench = true;
+		}
+		else if (std::strcmp(argv[i], "--format") == 0 && hasValue)
+		{
+			++i;
+			if (std::strcmp(argv[i], "csv") == 0)       out_options.m_format = eOutputFormat::CSV;
+			else if (std::strcmp(argv[i], "json") == 0) out_options.m_format = eOutputFormat::JSON;
+			else return false;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	if (out_options.m_numRays < 1) out_options.m_numRays = 1;
+	if (out_options.m_numRepeats < 1) out_options.m_numRepeats = 1;
+	if (out_options.m_packetSize < 1 || out_options.m_packetSize > MAX_RAY_PACKET_SIZE) return false;
+	return !out_options.m_objectCounts.empty();
+}
+
+//----------------------------------------------------------------------------------------------------
+// Bulk picking: random points through the linear IsPointInside scan GameConvexScene used for hover, then
+// through the SAH BVH and quadtree point batches. Returns false when a tree finds a different number of
+// convexes under any point.
+//----------------------------------------------------------------------------------------------------
+static bool RunPickBenchmark(std::vector<Convex2*> const& convexes, AABB2Tree const& aabb2TreeSAH, SymmetricQuadTree const& symQuadTree,
+                             AABB2 const& worldBounds, BenchmarkOptions const& options, RandomNumberGenerator& rng)
+{
+	std::vector<Vec2> points;
+	points.reserve(PICK_BENCH_POINTS);
+	for (int i = 0; i < PICK_BENCH_POINTS; ++i)
+	{
+		points.emplace_back(rng.RollRandomFloatInRange(worldBounds.m_mins.x, worldBounds.m_maxs.x),
+		                    rng.RollRandomFloatInRange(worldBounds.m_mins.y, worldBounds.m_maxs.y));
+	}
+
+	std::vector<int>      linearFirst;
+	std::vector<int>      bvhFirst;
+	std::vector<int>      quadTreeFirst;
+	std::vector<Convex2*> linearContaining;
+	std::vector<Convex2*> bvhContaining;
+	std::vector<Convex2*> quadTreeContaining;
+
+	auto runLinear = [&]()
+	{
+		linearFirst.clear();
+		linearContaining.clear();
+		for (Vec2 const& point : points)
+		{
+			linearFirst.push_back(static_cast<int>(linearContaining.size()));
+			for (Convex2* convex : convexes)
+			{
+				if (convex->IsPointInside(point)) linearContaining.push_back(convex);
+			}
+		}
+		linearFirst.push_back(static_cast<int>(linearContaining.size()));
+	};
+	auto runBVH      = [&]() { aabb2TreeSAH.SolvePointBatch(points.data(), PICK_BENCH_POINTS, bvhFirst, bvhContaining); };
+	auto runQuadTree = [&]() { symQuadTree.SolvePointBatch(points.data(), PICK_BENCH_POINTS, quadTreeFirst, quadTreeContaining); };
+	auto timeBestMs  = [&options](auto const& run)
+	{
+		double bestMs = 0.0;
+		for (int repeat = 0; repeat < options.m_numRepeats; ++repeat)
+		{
+			auto         startTime = std::chrono::steady_clock::now();
+			run();
+			double const elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+			if (repeat == 0 || elapsedMs < bestMs) bestMs = elapsedMs;
+		}
+		return bestMs;
+	};
+
+	double const linearMs   = timeBestMs(runLinear);
+	double const bvhMs      = timeBestMs(runBVH);
+	double const quadTreeMs = timeBestMs(runQuadTree);
+	bool const   isMatch    = (bvhFirst == linearFirst) && (quadTreeFirst == linearFirst);
+
+	double const msToNsPerPoint = 1e6 / static_cast<double>(PICK_BENCH_POINTS);
+	std::fprintf(stderr, "%d objects: pick %d points, linear %.1f ns/point, BVH-SAH %.1f ns/point (x%.1f), QuadTree %.1f ns/point (x%.1f), %d hits%s\n",
+	             static_cast<int>(convexes.size()), PICK_BENCH_POINTS, linearMs * msToNsPerPoint, bvhMs * msToNsPerPoint, linearMs / bvhMs,
+	             quadTreeMs * msToNsPerPoint, linearMs / quadTreeMs, linearFirst.back(), isMatch ? "" : " MISMATCH");
+	return isMatch;
+}
+
+//----------------------------------------------------------------------------------------------------
+// True when a tree's primitive array lists every convex of the scene exactly once and nothing else
+//----------------------------------------------------------------------------------------------------
+static bool DoesTreeHoldExactly(std::vector<Convex2*> primitives, std::vector<Convex2*> convexes)
+{
+	std::sort(primitives.begin(), primitives.end(), std::less<Convex2*>());
+	std::sort(convexes.begin(), convexes.end(), std::less<Convex2*>());
+	return primitives == convexes;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Builds one scene and keeps the fastest of numRepeats runs per strategy. Returns false when a rebuilt tree
+// kept convexes from its earlier build, or the pick benchmark ran and a tree disagreed with the linear scan.
+//----------------------------------------------------------------------------------------------------
+static bool RunSceneBenchmark(int numObjects, BenchmarkOptions const& options, RandomNumberGenerator& rng, std::vector<BenchmarkRow>& out_rows)
+{
+	AABB2 const worldBounds(Vec2(0.f, 0.f), Vec2(CONVEX_WORLD_SIZE_X, CONVEX_WORLD_SIZE_Y));
+
+	ConvexPool            convexPool;
+	std::vector<Convex2*> convexes;
+	convexes.reserve(numObjects);
+
+	size_t const allocationsBefore = s_numHeapAllocations;
+	auto         createStartTime   = std::chrono::steady_clock::now();
+	for (int i = 0; i < numObjects; ++i)
+	{
+		Vec2 randomPos(rng.RollRandomFloatInRange(worldBounds.m_mins.x, worldBounds.m_maxs.x),
+		               rng.RollRandomFloatInRange(worldBounds.m_mins.y, worldBounds.m_maxs.y));
+		convexes.push_back(CreateRandomConvex2(convexPool, rng, randomPos, MIN_CONVEX_RADIUS, MAX_CONVEX_RADIUS));
+	}
+	double const createMs       = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - createStartTime).count();
+	size_t const numAllocations = s_numHeapAllocations - allocationsBefore;
+
+	AABB2Tree         aabb2Tree;
+	AABB2Tree         aabb2TreeSAH;
+	AABB2Tree4        aabb2Tree4SAH;
+	SymmetricQuadTree symQuadTree;
+	AdaptiveQuadTree  adaptiveQuadTree;
+	AdaptiveQuadTree  looseQuadTree;
+	ConvexSceneStore  convexStore;
+	UniformGrid2D     uniformGrid;
+	// The game rebuilds its trees in place (RebuildAllTrees, the refit threshold, every TestRays), so the BVHs
+	// are first built over half the scene and then rebuilt over all of it; the strategies below run on the rebuilds
+	std::vector<Convex2*> const halfScene(convexes.begin(), convexes.begin() + numObjects / 2);
+	aabb2Tree.BuildTree(halfScene, GetDefaultAABB2TreeDepth(static_cast<int>(halfScene.size())), worldBounds);
+	aabb2TreeSAH.BuildTreeSAH(halfScene);
+	aabb2Tree.BuildTree(convexes, GetDefaultAABB2TreeDepth(numObjects), worldBounds);
+	aabb2TreeSAH.BuildTreeSAH(convexes);
+	aabb2Tree4SAH.BuildFromBinary(aabb2TreeSAH);
+
+	AABB2Tree emptiedTreeSAH;
+	emptiedTreeSAH.BuildTreeSAH(convexes);
+	emptiedTreeSAH.BuildTreeSAH(std::vector<Convex2*>());
+	bool const rebuildsMatch = DoesTreeHoldExactly(aabb2Tree.m_primitives, convexes) && DoesTreeHoldExactly(aabb2TreeSAH.m_primitives, convexes) &&
+	                           DoesTreeHoldExactly(aabb2Tree4SAH.m_primitives, convexes) && emptiedTreeSAH.m_primitives.empty();
+	if (!rebuildsMatch)
+	{
+		std::fprintf(stderr, "%d objects: REBUILT TREE HOLDS CONVEXES FROM AN EARLIER BUILD\n", numObjects);
+	}
+	symQuadTree.BuildTree(convexes, QUAD_TREE_DEPTH, worldBounds);
+	adaptiveQuadTree.BuildTree(convexes, worldBounds);
+	looseQuadTree.BuildTree(convexes, worldBounds, true);
+	convexStore.Build(convexes);
+	uniformGrid.BuildGrid(convexes);
+
+	size_t convexBytes = 0;
+	for (Convex2 const* convex : convexes)
+	{
+		convexBytes += ConvexSceneStore::GetConvexFootprintBytes(*convex);
+	}
+
+	// stderr keeps the CSV / JSON on stdout machine-readable
+	std::fprintf(stderr, "%d objects: created in %.3f ms with %zu heap allocations (%.2f per convex, %d pool blocks)\n", numObjects,
+	             createMs, numAllocations, static_cast<float>(numAllocations) / static_cast<float>(numObjects), convexPool.GetNumBlockAllocations());
+	std::fprintf(stderr, "%d objects: BVH %d nodes / %zu bytes, SAH %d nodes / %zu bytes, SAH4 %d nodes / %zu bytes\n", numObjects,
+	             static_cast<int>(aabb2Tree.m_nodes.size()), aabb2Tree.GetMemoryFootprintBytes(),
+	             static_cast<int>(aabb2TreeSAH.m_nodes.size()), aabb2TreeSAH.GetMemoryFootprintBytes(),
+	             static_cast<int>(aabb2Tree4SAH.m_nodes.size()), aabb2Tree4SAH.GetMemoryFootprintBytes());
+	std::fprintf(stderr, "%d objects: AdaptiveQT %d nodes / %zu bytes, LooseQT %d nodes / %zu bytes\n", numObjects,
+	             static_cast<int>(adaptiveQuadTree.m_nodes.size()), adaptiveQuadTree.GetMemoryFootprintBytes(),
+	             static_cast<int>(looseQuadTree.m_nodes.size()), looseQuadTree.GetMemoryFootprintBytes());
+	std::fprintf(stderr, "%d objects: Grid %dx%d cells / %zu bytes, %.2f convexes per cell\n", numObjects,
+	             uniformGrid.m_numCellsX, uniformGrid.m_numCellsY, uniformGrid.GetMemoryFootprintBytes(),
+	             static_cast<float>(uniformGrid.m_cellConvexes.size()) / static_cast<float>(uniformGrid.GetNumCells()));
+	std::fprintf(stderr, "%d objects: Convex2* %.1f bytes/object, SoA store %.1f bytes/object\n", numObjects,
+	             static_cast<float>(convexBytes) / static_cast<float>(numObjects),
+	             static_cast<float>(convexStore.GetMemoryFootprintBytes()) / static_cast<float>(numObjects));
+
+	RayBatch rays;
+	if (options.m_fanSize > 0)
+	{
+		GenerateRayFans(rays, options.m_numRays, options.m_fanSize, RAY_FAN_DEGREES, worldBounds, rng);
+	}
+	else
+	{
+		GenerateRandomRays(rays, options.m_numRays, worldBounds, rng);
+	}
+
+	float avgQuadTreeCells        = 0.f;
+	float avgQuadTreeClosestCells = 0.f;
+	MeasureQuadTreeCellsPerRay(symQuadTree, rays, avgQuadTreeCells, avgQuadTreeClosestCells);
+	std::fprintf(stderr, "%d objects: QuadTree %.2f cells/ray, QuadTree-Closest %.2f cells/ray\n", numObjects, avgQuadTreeCells, avgQuadTreeClosestCells);
+
+	double bvhFlatMs   = 0.0;
+	double bvhVectorMs = 0.0;
+	double sahFlatMs   = 0.0;
+	double sahVectorMs = 0.0;
+	bool const layoutsMatch = MeasureAABB2TreeLayouts(aabb2Tree, rays, bvhFlatMs, bvhVectorMs) &&
+	                          MeasureAABB2TreeLayouts(aabb2TreeSAH, rays, sahFlatMs, sahVectorMs);
+	std::fprintf(stderr, "%d objects: flat layout vs per-node vectors, BVH %.3f / %.3f ms (x%.2f), SAH %.3f / %.3f ms (x%.2f)%s\n", numObjects,
+	             bvhFlatMs, bvhVectorMs, bvhVectorMs / std::max(bvhFlatMs, 1e-6), sahFlatMs, sahVectorMs, sahVectorMs / std::max(sahFlatMs, 1e-6),
+	             layoutsMatch ? "" : ", CANDIDATES DIFFER");
+
+	bool const pickMatches = !options.m_pickBench || RunPickBenchmark(convexes, aabb2TreeSAH, symQuadTree, worldBounds, options, rng);
+
+	RayBenchmarkScene scene;
+	scene.m_convexes         = &convexes;
+	scene.m_convexStore      = &convexStore;
+	scene.m_symQuadTree      = &symQuadTree;
+	scene.m_adaptiveQuadTree = &adaptiveQuadTree;
+	scene.m_looseQuadTree    = &looseQuadTree;
+	scene.m_AABB2Tree        = &aabb2Tree;
+	scene.m_AABB2TreeSAH     = &aabb2TreeSAH;
+	scene.m_AABB2Tree4SAH    = &aabb2Tree4SAH;
+	scene.m_uniformGrid      = &uniformGrid;
+	scene.m_rayPacketSize    = options.m_packetSize;
+
+	std::vector<RayStrategyResult> best = RunAllRayStrategies(scene, rays);
+	for (int repeat = 1; repeat < options.m_numRepeats; ++repeat)
+	{
+		std::vector<RayStrategyResult> results = RunAllRayStrategies(scene, rays);
+		for (int s = 0; s < static_cast<int>(results.size()); ++s)
+		{
+			if (results[s].m_elapsedMs < best[s].m_elapsedMs) best[s].m_elapsedMs = results[s].m_elapsedMs;
+			best[s].m_matchesBaseline = best[s].m_matchesBaseline && results[s].m_matchesBaseline;
+		}
+	}
+
+	for (RayStrategyResult const& result : best)
+	{
+		BenchmarkRow row;
+		row.m_numObjects   = numObjects;
+		row.m_numRays      = options.m_numRays;
+		row.m_baselineHits = best[0].m_numOfRayHit;
+		row.m_result       = result;
+		out_rows.push_back(row);
+	}
+	return pickMatches && layoutsMatch && rebuildsMatch;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Exact convex test only, no rejection and no tree: every ray against every convex of one side count,
+// RaycastVsConvexHull2D against the RaycastVsPlanes2D path of Convex2. Returns false when a hit differs, a
+// length or normal differs beyond HULL_BENCH_TOLERANCE, or an inside start breaks the kernel's normal convention.
+//----------------------------------------------------------------------------------------------------
+static bool RunHullClipBenchmark(BenchmarkOptions const& options, RandomNumberGenerator& rng)
+{
+	AABB2 const worldBounds(Vec2(0.f, 0.f), Vec2(CONVEX_WORLD_SIZE_X, CONVEX_WORLD_SIZE_Y));
+	bool        allMatch = true;
+
+	RayBatch rays;
+	GenerateRandomRays(rays, HULL_BENCH_RAYS, worldBounds, rng);
+
+	for (int numSides = MIN_RANDOM_CONVEX_SIDES; numSides <= MAX_RANDOM_CONVEX_SIDES; ++numSides)
+	{
+		ConvexPool            convexPool;
+		std::vector<Convex2*> convexes;
+		for (int i = 0; i < HULL_BENCH_CONVEXES; ++i)
+		{
+			Vec2 randomPos(rng.RollRandomFloatInRange(worldBounds.m_mins.x, worldBounds.m_maxs.x),
+			               rng.RollRandomFloatInRange(worldBounds.m_mins.y, worldBounds.m_maxs.y));
+			convexes.push_back(CreateRandomConvex2(convexPool, rng, randomPos, MIN_CONVEX_RADIUS, MAX_CONVEX_RADIUS, numSides));
+		}
+
+		double bestHullMs  = 0.0;
+		double bestPlaneMs = 0.0;
+		int    hullHits    = 0;
+		int    planeHits   = 0;
+		float  hullSum     = 0.f;
+		float  planeSum    = 0.f;
+		for (int repeat = 0; repeat < options.m_numRepeats; ++repeat)
+		{
+			hullHits = 0;
+			hullSum  = 0.f;
+			auto hullStartTime = std::chrono::steady_clock::now();
+			for (int r = 0; r < rays.GetNumRays(); ++r)
+			{
+				for (Convex2 const* convex : convexes)
+				{
+					RaycastResult2D rayRes = RaycastVsConvexHull2D(rays.m_startPos[r], rays.m_forwardNormal[r], rays.m_maxDist[r], convex->m_convexHull);
+					if (rayRes.m_didImpact) { ++hullHits; hullSum += rayRes.m_impactLength; }
+				}
+			}
+			double const hullMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - hullStartTime).count();
+
+			planeHits = 0;
+			planeSum  = 0.f;
+			auto planeStartTime = std::chrono::steady_clock::now();
+			for (int r = 0; r < rays.GetNumRays(); ++r)
+			{
+				RaySlab2D const ray(rays.m_startPos[r], rays.m_forwardNormal[r], rays.m_maxDist[r]);
+				RaycastResult2D rayRes;
+				for (Convex2* convex : convexes)
+				{
+					if (convex->RayCastVsConvex2D<eRayRejection::NONE>(rayRes, ray)) { ++planeHits; planeSum += rayRes.m_impactLength; }
+				}
+			}
+			double const planeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - planeStartTime).count();
+
+			if (repeat == 0 || hullMs < bestHullMs)   bestHullMs  = hullMs;
+			if (repeat == 0 || planeMs < bestPlaneMs) bestPlaneMs = planeMs;
+		}
+
+		// Untimed pass comparing every result: hits, lengths and normals against the Engine, except that a start
+		// inside the hull must report RaycastVsPlanes2D's own convention (length 0, normal -forward)
+		auto isNearlyEqual = [](float a, float b) { return std::fabs(a - b) <= HULL_BENCH_TOLERANCE * std::max(1.f, std::fabs(a)); };
+		int numStartsInside  = 0;
+		int numResultsDiffer = 0;
+		for (int r = 0; r < rays.GetNumRays(); ++r)
+		{
+			Vec2 const&     forwardNormal = rays.m_forwardNormal[r];
+			RaySlab2D const ray(rays.m_startPos[r], forwardNormal, rays.m_maxDist[r]);
+			RaycastResult2D planeRes;
+			for (Convex2* convex : convexes)
+			{
+				RaycastResult2D const hullRes = RaycastVsConvexHull2D(rays.m_startPos[r], forwardNormal, rays.m_maxDist[r], convex->m_convexHull);
+				convex->RayCastVsConvex2D<eRayRejection::NONE>(planeRes, ray);
+				if (hullRes.m_didImpact != planeRes.m_didImpact)
+				{
+					++numResultsDiffer;
+					continue;
+				}
+				if (!hullRes.m_didImpact) continue;
+
+				bool isSame = isNearlyEqual(hullRes.m_impactLength, planeRes.m_impactLength);
+				if (planeRes.m_impactLength == 0.f)
+				{
+					++numStartsInside;
+					isSame = isSame && planeRes.m_impactNormal.x == -forwardNormal.x && planeRes.m_impactNormal.y == -forwardNormal.y;
+				}
+				else
+				{
+					isSame = isSame && isNearlyEqual(hullRes.m_impactNormal.x, planeRes.m_impactNormal.x) &&
+					         isNearlyEqual(hullRes.m_impactNormal.y, planeRes.m_impactNormal.y);
+				}
+				if (!isSame) ++numResultsDiffer;
+			}
+		}
+
+		bool const isMatch = (hullHits == planeHits) && isNearlyEqual(hullSum, planeSum) && (numResultsDiffer == 0);
+		allMatch = allMatch && isMatch;
+
+		double const numTests = static_cast<double>(rays.GetNumRays()) * static_cast<double>(convexes.size());
+		std::fprintf(stderr, "Hull clip, %d sides: RaycastVsConvexHull2D %.2f ns/test, RaycastVsPlanes2D %.2f ns/test (x%.2f), %d hits (%d inside), %d results differ%s\n",
+		             numSides, bestHullMs * 1e6 / numTests, bestPlaneMs * 1e6 / numTests, bestHullMs / bestPlaneMs, planeHits, numStartsInside,
+		             numResultsDiffer, isMatch ? "" : " MISMATCH");
+	}
+	return allMatch;
+}
+
+//----------------------------------------------------------------------------------------------------
+static void PrintRowsAsCSV(std::vector<BenchmarkRow> const& rows)
+{
+	std::printf("objects,rays,strategy,total_ms,ns_per_ray,rays_per_sec,hits,baseline_hits,hits_match\n");
+	for (BenchmarkRow const& row : rows)
+	{
+		RayStrategyResult const& r = row.m_result;
+		std::printf("%d,%d,%s,%.3f,%.1f,%.0f,%d,%d,%d\n",
+		            row.m_numObjects, row.m_numRays, GetRayStrategyName(r.m_strategy), r.m_elapsedMs,
+		            r.GetNanosecondsPerRay(row.m_numRays), r.GetRaysPerSecond(row.m_numRays),
+		            r.m_numOfRayHit, row.m_baselineHits, r.m_matchesBaseline ? 1 : 0);
+	}
+}
+
+//----------------------------------------------------------------------------------------------------
+static void PrintRowsAsJSON(std::vector<BenchmarkRow> const& rows)
+{
+	std::printf("[\n");
+	for (int i = 0; i < static_cast<int>(rows.size()); ++i)
+	{
+		BenchmarkRow const&      row = rows[i];
+		RayStrategyResult const& r   = row.m_result;
+		std::printf("  {\"objects\": %d, \"rays\": %d, \"strategy\": \"%s\", \"total_ms\": %.3f, \"ns_per_ray\": %.1f, "
+		            "\"rays_per_sec\": %.0f, \"hits\": %d, \"baseline_hits\": %d, \"hits_match\": %s}%s\n",
+		            row.m_numObjects, row.m_numRays, GetRayStrategyName(r.m_strategy), r.m_elapsedMs,
+		            r.GetNanosecondsPerRay(row.m_numRays), r.GetRaysPerSecond(row.m_numRays),
+		            r.m_numOfRayHit, row.m_baselineHits, r.m_matchesBaseline ? "true" : "false",
+		            (i + 1 < static_cast<int>(rows.size())) ? "," : "");
+	}
+	std::printf("]\n");
+}
+
+//----------------------------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+	BenchmarkOptions options;
+	if (!ParseOptions(argc, argv, options))
+	{
+		std::fprintf(stderr, "Usage: %s [--objects 64,512,2048] [--rays 65536] [--repeat 3] [--format csv|json] [--fan-size 0] [--packet-size 16] [--hull-bench] [--pick-bench]\n", argv[0]);
+		return 2;
+	}
+
+	RandomNumberGenerator    rng;
+	bool const               hullClipMatches = !options.m_hullBench || RunHullClipBenchmark(options, rng);
+	bool                     pickMatches     = true;
+	std::vector<BenchmarkRow> rows;
+	for (int numObjects : options.m_objectCounts)
+	{
+		pickMatches = RunSceneBenchmark(numObjects, options, rng, rows) && pickMatches;
+	}
+
+	if (options.m_format == eOutputFormat::JSON) PrintRowsAsJSON(rows);
+	else                                         PrintRowsAsCSV(rows);
+
+	for (BenchmarkRow const& row : rows)
+	{
+		if (!row.m_result.m_matchesBaseline)
+		{
+			return 1;
+		}
+	}
+	return (hullClipMatches && pickMatches) ? 0 : 1;
+}